@@ -15,9 +15,16 @@ public:
     FileInterface_SDL() = default;
     ~FileInterface_SDL() override = default;
 
+    // Paths starting with prefix (e.g. "work:") are opened relative to root.
+    // RmlUi passes such paths through JoinPath untouched, like drive-letter paths.
+    void SetAlias(const Rml::String &prefix, const std::filesystem::path &root)
+    {
+        aliases_[prefix] = root;
+    }
+
     Rml::FileHandle Open(const Rml::String &path) override
     {
-        SDL_IOStream *io_stream = SDL_IOFromFile(path.c_str(), "rb");
+        SDL_IOStream *io_stream = SDL_IOFromFile(Resolve(path).c_str(), "rb");
         if (!io_stream)
         {
 #ifdef DEBUG_BUILD_TYPE
@@ -111,6 +118,16 @@ public:
     }
 
 private:
+    Rml::String Resolve(const Rml::String &path) const
+    {
+        for (const auto &[prefix, root] : aliases_)
+            if (path.compare(0, prefix.size(), prefix) == 0)
+                return (root / path.substr(prefix.size())).string();
+        return path;
+    }
+
+private:
+    std::map<Rml::String, std::filesystem::path> aliases_;
     using FileHandle = size_t; // Define FileHandle explicitly as size_t
     std::map<FileHandle, SDL_IOStream *> file_map_;
     FileHandle next_file_handle_id_ = 1; // Start from 1, 0 is reserved for invalid
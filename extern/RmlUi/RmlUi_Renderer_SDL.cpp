@@ -1,4 +1,5 @@
 #include "RmlUi_Renderer_SDL.h"
+#include "RmlUi_VertexKernel.h"
 #include <RmlUi/Core/Core.h>
 #include <RmlUi/Core/FileInterface.h>
 #include <RmlUi/Core/Types.h>
@@ -90,61 +91,88 @@ void RenderInterface_SDL::SetTransform(const Rml::Matrix4f* transform)
 	// Called by RmlUi when the active transform changes. nullptr means identity.
 	if (!transforms_enabled || !transform)
 	{
+		if (transform_active)
+			++transform_version;
 		transform_active = false;
 		return;
 	}
 	current_transform = *transform;
 	transform_active = !IsApproximatelyIdentity(current_transform);
+	++transform_version;
 }
 
 
 Rml::CompiledGeometryHandle RenderInterface_SDL::CompileGeometry(Rml::Span<const Rml::Vertex> vertices, Rml::Span<const int> indices)
 {
-	GeometryView* data = new GeometryView{vertices, indices};
-	return reinterpret_cast<Rml::CompiledGeometryHandle>(data);
+	Rml::UniquePtr<CompiledGeometry> geometry;
+	if (geometry_pool.empty())
+		geometry = Rml::MakeUnique<CompiledGeometry>();
+	else
+	{
+		geometry = std::move(geometry_pool.back());
+		geometry_pool.pop_back();
+	}
+
+	// RmlUi keeps the source data alive until ReleaseGeometry, so the indices are not copied.
+	geometry->indices = indices;
+	geometry->cache_valid = false;
+	geometry->vertices.resize(vertices.size());
+	RmlVertexKernel::ConvertVertices(vertices.data(), geometry->vertices.data(), vertices.size());
+
+	return reinterpret_cast<Rml::CompiledGeometryHandle>(geometry.release());
 }
 
-void RenderInterface_SDL::ReleaseGeometry(Rml::CompiledGeometryHandle geometry)
+void RenderInterface_SDL::ReleaseGeometry(Rml::CompiledGeometryHandle handle)
 {
-	delete reinterpret_cast<GeometryView*>(geometry);
+	CompiledGeometry* geometry = reinterpret_cast<CompiledGeometry*>(handle);
+	if (geometry_pool.size() >= max_pooled_geometries)
+	{
+		delete geometry;
+		return;
+	}
+	geometry_pool.emplace_back(geometry);
 }
 
-void RenderInterface_SDL::RenderGeometry(Rml::CompiledGeometryHandle handle, Rml::Vector2f translation, Rml::TextureHandle texture)
+const SDL_Vertex* RenderInterface_SDL::GetTransformedVertices(CompiledGeometry& geometry, Rml::Vector2f translation)
 {
-	const GeometryView* geometry = reinterpret_cast<GeometryView*>(handle);
-	const Rml::Vertex* vertices = geometry->vertices.data();
-	const size_t num_vertices = geometry->vertices.size();
-	const int* indices = geometry->indices.data();
-	const size_t num_indices = geometry->indices.size();
+	if (!transform_active && translation.x == 0.f && translation.y == 0.f)
+		return geometry.vertices.data();
 
-	Rml::UniquePtr<SDL_Vertex[]> sdl_vertices{new SDL_Vertex[num_vertices]};
+	if (geometry.cache_valid && geometry.cached_translation == translation && geometry.cached_transform_version == transform_version)
+		return geometry.transformed.data();
 
-	for (size_t i = 0; i < num_vertices; i++)
+	const size_t num_vertices = geometry.vertices.size();
+	geometry.transformed.resize(num_vertices);
+	if (!transform_active || RmlVertexKernel::IsAffine2D(current_transform))
 	{
-		float x = vertices[i].position.x + translation.x;
-		float y = vertices[i].position.y + translation.y;
-		if (transform_active)
+		const RmlVertexKernel::Affine2D affine = RmlVertexKernel::MakeAffine2D(transform_active ? &current_transform : nullptr, translation);
+		RmlVertexKernel::TransformVertices(geometry.vertices.data(), geometry.transformed.data(), num_vertices, affine);
+	}
+	else
+	{
+		// Projective transform: per-vertex divide by w.
+		for (size_t i = 0; i < num_vertices; i++)
 		{
-			SDL_FPoint p = ApplyTransform2D(current_transform, x, y);
-			x = p.x;
-			y = p.y;
+			SDL_Vertex& out = geometry.transformed[i];
+			out = geometry.vertices[i];
+			out.position = ApplyTransform2D(current_transform, out.position.x + translation.x, out.position.y + translation.y);
 		}
-		sdl_vertices[i].position = {x, y};
+	}
 
-		// sdl_vertices[i].position = {vertices[i].position.x + translation.x, vertices[i].position.y + translation.y};
-		sdl_vertices[i].tex_coord = {vertices[i].tex_coord.x, vertices[i].tex_coord.y};
+	geometry.cached_translation = translation;
+	geometry.cached_transform_version = transform_version;
+	geometry.cache_valid = true;
+	return geometry.transformed.data();
+}
 
-		const auto& color = vertices[i].colour;
-#if SDL_MAJOR_VERSION >= 3
-		sdl_vertices[i].color = {color.red / 255.f, color.green / 255.f, color.blue / 255.f, color.alpha / 255.f};
-#else
-		sdl_vertices[i].color = {color.red, color.green, color.blue, color.alpha};
-#endif
-	}
+void RenderInterface_SDL::RenderGeometry(Rml::CompiledGeometryHandle handle, Rml::Vector2f translation, Rml::TextureHandle texture)
+{
+	CompiledGeometry* geometry = reinterpret_cast<CompiledGeometry*>(handle);
+	const SDL_Vertex* sdl_vertices = GetTransformedVertices(*geometry, translation);
 
 	SDL_Texture* sdl_texture = (SDL_Texture*)texture;
 
-	SDL_RenderGeometry(renderer, sdl_texture, sdl_vertices.get(), (int)num_vertices, indices, (int)num_indices);
+	SDL_RenderGeometry(renderer, sdl_texture, sdl_vertices, (int)geometry->vertices.size(), geometry->indices.data(), (int)geometry->indices.size());
 }
 
 void RenderInterface_SDL::EnableScissorRegion(bool enable)
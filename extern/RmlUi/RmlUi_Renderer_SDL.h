@@ -39,12 +39,25 @@ public:
     void SetScissorRegion(Rml::Rectanglei region) override;
 
 private:
-    struct GeometryView
+    // Geometry converted to SDL vertices once at compile time. The transformed copy is
+    // rebuilt only when the translation or the active transform changes.
+    struct CompiledGeometry
     {
-        Rml::Span<const Rml::Vertex> vertices;
+        Rml::Vector<SDL_Vertex> vertices;
+        Rml::Vector<SDL_Vertex> transformed;
         Rml::Span<const int> indices;
+
+        Rml::Vector2f cached_translation;
+        unsigned int cached_transform_version = 0;
+        bool cache_valid = false;
     };
 
+    const SDL_Vertex *GetTransformedVertices(CompiledGeometry &geometry, Rml::Vector2f translation);
+
+    // Released geometries are reused to keep their vertex buffers allocated.
+    static constexpr size_t max_pooled_geometries = 256;
+    Rml::Vector<Rml::UniquePtr<CompiledGeometry>> geometry_pool;
+
     SDL_Renderer *renderer;
     SDL_BlendMode blend_mode = {};
     SDL_Rect rect_scissor = {};
@@ -54,4 +67,6 @@ private:
     bool transforms_enabled = false;
     bool transform_active = false;
     Rml::Matrix4f current_transform;
+    // Incremented whenever the active transform changes, invalidates transformed geometry.
+    unsigned int transform_version = 0;
 };
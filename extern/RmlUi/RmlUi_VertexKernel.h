@@ -0,0 +1,179 @@
+#pragma once
+
+#include <RmlUi/Core/Types.h>
+#include <RmlUi/Core/Vertex.h>
+
+#if RMLUI_SDL_VERSION_MAJOR == 3
+#include <SDL3/SDL.h>
+#else
+#include <SDL.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RMLUI_VERTEX_KERNEL_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define RMLUI_VERTEX_KERNEL_NEON
+#include <arm_neon.h>
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Vertex conversion and 2D transform used by RenderInterface_SDL.
+// SSE2 / NEON paths handle several vertices per iteration, the scalar versions are the reference and the fallback.
+namespace RmlVertexKernel {
+
+inline const char* Name()
+{
+#if defined(RMLUI_VERTEX_KERNEL_SSE2)
+	return "SSE2";
+#elif defined(RMLUI_VERTEX_KERNEL_NEON)
+	return "NEON";
+#else
+	return "scalar";
+#endif
+}
+
+// Affine 2D part of a column-major matrix plus the translation folded into the offset.
+struct Affine2D {
+	float m00, m01, m10, m11;
+	float tx, ty;
+};
+
+inline bool IsAffine2D(const Rml::Matrix4f& m)
+{
+	return m[0][3] == 0.f && m[1][3] == 0.f && m[3][3] == 1.f;
+}
+
+inline Affine2D MakeAffine2D(const Rml::Matrix4f* m, Rml::Vector2f translation)
+{
+	if (!m)
+		return {1.f, 0.f, 0.f, 1.f, translation.x, translation.y};
+	const Rml::Matrix4f& t = *m;
+	return {t[0][0], t[0][1], t[1][0], t[1][1], t[0][0] * translation.x + t[1][0] * translation.y + t[3][0],
+		t[0][1] * translation.x + t[1][1] * translation.y + t[3][1]};
+}
+
+inline void ConvertVertexScalar(const Rml::Vertex& in, SDL_Vertex& out)
+{
+	out.position = {in.position.x, in.position.y};
+	out.tex_coord = {in.tex_coord.x, in.tex_coord.y};
+#if SDL_MAJOR_VERSION >= 3
+	out.color = {in.colour.red / 255.f, in.colour.green / 255.f, in.colour.blue / 255.f, in.colour.alpha / 255.f};
+#else
+	out.color = {in.colour.red, in.colour.green, in.colour.blue, in.colour.alpha};
+#endif
+}
+
+inline void ConvertVerticesScalar(const Rml::Vertex* in, SDL_Vertex* out, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+		ConvertVertexScalar(in[i], out[i]);
+}
+
+// Copies positions and texture coordinates, converts colours from bytes to [0, 1] floats.
+inline void ConvertVertices(const Rml::Vertex* in, SDL_Vertex* out, size_t count)
+{
+#if SDL_MAJOR_VERSION >= 3 && (defined(RMLUI_VERTEX_KERNEL_SSE2) || defined(RMLUI_VERTEX_KERNEL_NEON))
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		std::uint32_t colours[4];
+		for (size_t j = 0; j < 4; j++)
+		{
+			std::memcpy(&colours[j], &in[i + j].colour, sizeof(std::uint32_t));
+			out[i + j].position = {in[i + j].position.x, in[i + j].position.y};
+			out[i + j].tex_coord = {in[i + j].tex_coord.x, in[i + j].tex_coord.y};
+		}
+#if defined(RMLUI_VERTEX_KERNEL_SSE2)
+		const __m128 scale = _mm_set1_ps(1.f / 255.f);
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(colours));
+		const __m128i lo = _mm_unpacklo_epi8(bytes, zero);
+		const __m128i hi = _mm_unpackhi_epi8(bytes, zero);
+		_mm_storeu_ps(&out[i + 0].color.r, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)), scale));
+		_mm_storeu_ps(&out[i + 1].color.r, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)), scale));
+		_mm_storeu_ps(&out[i + 2].color.r, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)), scale));
+		_mm_storeu_ps(&out[i + 3].color.r, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)), scale));
+#else
+		const uint8x16_t bytes = vld1q_u8(reinterpret_cast<const uint8_t*>(colours));
+		const uint16x8_t lo = vmovl_u8(vget_low_u8(bytes));
+		const uint16x8_t hi = vmovl_u8(vget_high_u8(bytes));
+		vst1q_f32(&out[i + 0].color.r, vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(lo))), 1.f / 255.f));
+		vst1q_f32(&out[i + 1].color.r, vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(lo))), 1.f / 255.f));
+		vst1q_f32(&out[i + 2].color.r, vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(hi))), 1.f / 255.f));
+		vst1q_f32(&out[i + 3].color.r, vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(hi))), 1.f / 255.f));
+#endif
+	}
+	ConvertVerticesScalar(in + i, out + i, count - i);
+#else
+	ConvertVerticesScalar(in, out, count);
+#endif
+}
+
+inline void TransformVerticesScalar(const SDL_Vertex* in, SDL_Vertex* out, size_t count, const Affine2D& a)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		const float x = in[i].position.x;
+		const float y = in[i].position.y;
+		out[i] = in[i];
+		out[i].position = {a.m00 * x + a.m10 * y + a.tx, a.m01 * x + a.m11 * y + a.ty};
+	}
+}
+
+// out = affine * (in + translation); colours and texture coordinates are copied.
+// in and out may be the same buffer.
+inline void TransformVertices(const SDL_Vertex* in, SDL_Vertex* out, size_t count, const Affine2D& a)
+{
+#if defined(RMLUI_VERTEX_KERNEL_SSE2)
+	// Two vertices per iteration: [x0 y0 x1 y1]
+	const __m128 col0 = _mm_setr_ps(a.m00, a.m01, a.m00, a.m01);
+	const __m128 col1 = _mm_setr_ps(a.m10, a.m11, a.m10, a.m11);
+	const __m128 offset = _mm_setr_ps(a.tx, a.ty, a.tx, a.ty);
+	size_t i = 0;
+	for (; i + 2 <= count; i += 2)
+	{
+		__m128 p = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(&in[i].position));
+		p = _mm_loadh_pi(p, reinterpret_cast<const __m64*>(&in[i + 1].position));
+		const __m128 xs = _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 2, 0, 0));
+		const __m128 ys = _mm_shuffle_ps(p, p, _MM_SHUFFLE(3, 3, 1, 1));
+		const __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(xs, col0), _mm_mul_ps(ys, col1)), offset);
+		if (out != in)
+		{
+			out[i] = in[i];
+			out[i + 1] = in[i + 1];
+		}
+		_mm_storel_pi(reinterpret_cast<__m64*>(&out[i].position), r);
+		_mm_storeh_pi(reinterpret_cast<__m64*>(&out[i + 1].position), r);
+	}
+	TransformVerticesScalar(in + i, out + i, count - i, a);
+#elif defined(RMLUI_VERTEX_KERNEL_NEON)
+	const float32x4_t col0 = {a.m00, a.m01, a.m00, a.m01};
+	const float32x4_t col1 = {a.m10, a.m11, a.m10, a.m11};
+	const float32x4_t offset = {a.tx, a.ty, a.tx, a.ty};
+	size_t i = 0;
+	for (; i + 2 <= count; i += 2)
+	{
+		const float32x2_t p0 = vld1_f32(&in[i].position.x);
+		const float32x2_t p1 = vld1_f32(&in[i + 1].position.x);
+		const float32x4_t xs = vcombine_f32(vdup_lane_f32(p0, 0), vdup_lane_f32(p1, 0));
+		const float32x4_t ys = vcombine_f32(vdup_lane_f32(p0, 1), vdup_lane_f32(p1, 1));
+		const float32x4_t r = vmlaq_f32(vmlaq_f32(offset, xs, col0), ys, col1);
+		if (out != in)
+		{
+			out[i] = in[i];
+			out[i + 1] = in[i + 1];
+		}
+		vst1_f32(&out[i].position.x, vget_low_f32(r));
+		vst1_f32(&out[i + 1].position.x, vget_high_f32(r));
+	}
+	TransformVerticesScalar(in + i, out + i, count - i, a);
+#else
+	TransformVerticesScalar(in, out, count, a);
+#endif
+}
+
+} // namespace RmlVertexKernel
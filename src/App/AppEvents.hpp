@@ -9,7 +9,6 @@ namespace app
 enum AppEventsType : std::uint32_t
 {
     BEGIN_INVALID_TYPE = SDL_EVENT_USER,
-    COLLISION,
     GAME_OBJECT_SPAWNED
 };
 
@@ -3,12 +3,17 @@
 #include "Core/Managers/AudioManager.hpp"
 #include "IO/FullFileWorker.hpp"
 #include <App/IO/GameStatisticIO.hpp>
+#include <App/IO/StatisticJournal.hpp>
 #include <Core/Managers/TextureManager.hpp>
+#include <App/Render/AtlasCache.hpp>
+#include <App/Render/ImageCache.hpp>
+#include <App/Resources/PackIndex.hpp>
 #include <App/Statistic/GameStatistic.hpp>
 #include <SDLWrapper/FileWorker.hpp>
 
 #include <SDL3/SDL_log.h>
 
+#include <cstddef>
 #include <filesystem>
 #include <string>
 
@@ -18,9 +23,23 @@ namespace app
 class AppState
 {
 public:
+    // Бюджеты общих кэшей ресурсов. Ресурсы идущей игры держатся ссылками и не вытесняются, даже сверх бюджета
+    inline static constexpr const std::size_t imageBudget = 96u << 20;
+    inline static constexpr const std::size_t audioBudget = 64u << 20;
+    inline static constexpr const std::size_t textureBudget = 64u << 20;
+    inline static constexpr const std::size_t atlasBudget = 64u << 20;
+
+public:
+    AppState()
+    {
+        setCacheBudget(imageBudget, audioBudget, textureBudget, atlasBudget);
+    }
+
+    // Рядом с stat.xml ложатся снимок stat.bin и журнал stat.journal
     void setWorkStatisticFile(const std::filesystem::path &workStatFile)
     {
         workStatFile_ = workStatFile;
+        store_.setFiles(std::filesystem::path(workStatFile).replace_extension(".bin"), std::filesystem::path(workStatFile).replace_extension(".journal"));
     }
     void setAssetsStatisticFile(const std::filesystem::path &assetsStatFile)
     {
@@ -29,19 +48,52 @@ public:
 
     bool load()
     {
+        if (store_.load(stat_, currentPackageName_, volume_))
+        {
+            store_.start();
+            return true;
+        }
+
+        // Первый запуск или статистика старой версии: импорт из stat.xml
         if(!IO::isValidXmlFile(workStatFile_))
             IO::createAndMove(assetsStatFile_, workStatFile_);
-        return IO::readAllGameStatistic(stat_, currentPackageName_, volume_, workStatFile_);
+        if (!IO::readAllGameStatistic(stat_, currentPackageName_, volume_, workStatFile_))
+            return false;
+        if (!store_.reset(stat_, currentPackageName_, volume_))
+            SDL_Log("Statistic snapshot is not written");
+        store_.start();
+        return true;
     }
 
-    bool save() const
+    // Дописывает несохранённое и останавливает поток записи (выход)
+    void save()
     {
-        return IO::writeAllGameStatistic(stat_, currentPackageName_, volume_, workStatFile_);
+        store_.stop();
     }
 
-    statistic::AllGameStatistic &stat()
+    // Записать несохранённое сейчас и дождаться записи (уход в фон)
+    void flush()
     {
-        return stat_;
+        store_.flush();
+    }
+
+    // Изменения статистики - только через эти методы, чтобы они попали на диск
+    bool applyGameResult(const statistic::GameID id, const statistic::GameStatistic &result)
+    {
+        const statistic::GameStatistic *gs = stat_.get(id);
+        if (!gs)
+            return false;
+        stat_.applyGameResult(id, result);
+        // Итог игры пишется сразу (одна запись на игру); debounce - только для настроек
+        store_.putGame(*gs, true);
+        return true;
+    }
+
+    void resetAllStatistic()
+    {
+        stat_.resetAllStatistic();
+        for (const auto &gs : stat_.getAll())
+            store_.putGame(gs, true);
     }
 
     const statistic::AllGameStatistic &stat() const
@@ -61,13 +113,18 @@ public:
 
     void setVolume(const float volume)
     {
+        if (volume_ == volume)
+            return;
         volume_ = volume;
+        store_.putSettings(currentPackageName_, volume_);
     }
 
     void setCurrentPackageName(std::string name)
     {
-        if (!name.empty())
-            currentPackageName_ = std::move(name);
+        if (name.empty() || name == currentPackageName_)
+            return;
+        currentPackageName_ = std::move(name);
+        store_.putSettings(currentPackageName_, volume_);
     }
 
     core::managers::TextureManager &textures()
@@ -88,6 +145,57 @@ public:
         return audios_;
     }
 
+    // Картинки пакетов, декодированные при прогреве
+    render::ImageCache &images()
+    {
+        return images_;
+    }
+
+    // Атласы пакетов на GPU, переживают сцену игры
+    render::AtlasCache &atlases()
+    {
+        return atlases_;
+    }
+
+    void setCacheBudget(const std::size_t images, const std::size_t audios, const std::size_t textures, const std::size_t atlases)
+    {
+        images_.setBudget(images);
+        audios_.setBudget(audios);
+        textures_.setBudget(textures);
+        atlases_.setBudget(atlases);
+    }
+
+    // Текстуры и атласы - ресурсы renderer: до его уничтожения, а не в деструкторе статического AppState
+    void releaseGpuResources()
+    {
+        atlases_.clear();
+        textures_.clear();
+    }
+
+    void logCacheStats() const
+    {
+        auto log = [](const char *name, const core::managers::CacheStats &stats)
+        {
+            SDL_Log("Cache %s: %llu hits, %llu misses, %llu evicted, %.1f of %.1f MB", name,
+                    static_cast<unsigned long long>(stats.hits), static_cast<unsigned long long>(stats.misses), static_cast<unsigned long long>(stats.evictions),
+                    stats.bytes / 1048576.0, stats.budget / 1048576.0);
+        };
+        log("images", images_.stats());
+        log("sounds", audios_.stats());
+        log("textures", textures_.stats());
+        log("atlases", atlases_.stats());
+    }
+
+    // Карточки пакетов для меню выбора
+    resources::PackIndex &packIndex()
+    {
+        return packIndex_;
+    }
+    const resources::PackIndex &packIndex() const
+    {
+        return packIndex_;
+    }
+
 private:
     std::filesystem::path workStatFile_;
     std::filesystem::path assetsStatFile_;
@@ -97,6 +205,10 @@ private:
 
     core::managers::TextureManager textures_;
     core::managers::AudioManager audios_;
+    render::ImageCache images_;
+    render::AtlasCache atlases_;
+    resources::PackIndex packIndex_;
+    IO::StatisticStore store_;
 };
 
 using AppStatePtr = std::shared_ptr<AppState>;
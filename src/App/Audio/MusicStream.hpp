@@ -0,0 +1,235 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <SDL3/SDL_audio.h>
+#include <SDL3/SDL_iostream.h>
+#include <SDL3/SDL_log.h>
+#include <SDL3_mixer/SDL_mixer.h>
+
+#include <App/IO/MappedFile.hpp>
+
+namespace audio
+{
+
+// Фоновая музыка без полного декодирования: файл отображается в память (IO::MappedFile),
+// фоновый поток декодирует его кусками в небольшое кольцо, поток звука SDL забирает из кольца.
+// В памяти - сжатый файл и bufferMs PCM, а не весь трек.
+class MusicStream
+{
+public:
+    inline static constexpr const unsigned int bufferMs = 500;
+    inline static constexpr const int chunkBytes = 16 * 1024;
+
+public:
+    MusicStream() = default;
+    MusicStream(const MusicStream &) = delete;
+    MusicStream &operator=(const MusicStream &) = delete;
+    ~MusicStream()
+    {
+        close();
+    }
+
+    // Открывает файл и заполняет кольцо; звук пойдёт после play()
+    bool open(const std::filesystem::path &file, const bool loop = true)
+    {
+        close();
+        if (!file_.open(file))
+        {
+            SDL_Log("MusicStream: can't open %s", file.string().c_str());
+            return false;
+        }
+        loop_ = loop;
+        if (!openDecoder() || !MIX_GetAudioDecoderFormat(decoder_, &spec_))
+        {
+            SDL_Log("MusicStream: %s: %s", file.string().c_str(), SDL_GetError());
+            close();
+            return false;
+        }
+
+        const std::size_t frame = static_cast<std::size_t>(SDL_AUDIO_FRAMESIZE(spec_));
+        const std::size_t frames = static_cast<std::size_t>(spec_.freq) * bufferMs / 1000;
+        ring_.assign(std::max<std::size_t>(frames * frame, 2 * chunkBytes), 0);
+        head_ = 0;
+        tail_ = 0;
+
+        stream_ = SDL_OpenAudioDeviceStream(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &spec_, &MusicStream::feed, this);
+        if (!stream_)
+        {
+            SDL_Log("MusicStream: %s", SDL_GetError());
+            close();
+            return false;
+        }
+        // Начало трека - сразу, чтобы play() не начинался с тишины
+        std::vector<unsigned char> chunk(chunkBytes);
+        Step step = Step::Decoded;
+        while (step == Step::Decoded)
+            step = decodeStep(chunk);
+        if (step == Step::Finished)
+            return true;
+        stop_ = false;
+        worker_ = std::thread([this]() { decodeLoop(); });
+        return true;
+    }
+
+    // gain - громкость 0..1; устройство потока создаётся на паузе
+    void play(const float gain = 1.f)
+    {
+        if (!stream_)
+            return;
+        SDL_SetAudioStreamGain(stream_, gain);
+        SDL_ResumeAudioStreamDevice(stream_);
+    }
+
+    void pause(const bool pause)
+    {
+        if (!stream_)
+            return;
+        if (pause)
+            SDL_PauseAudioStreamDevice(stream_);
+        else
+            SDL_ResumeAudioStreamDevice(stream_);
+    }
+
+    void setGain(const float gain)
+    {
+        if (stream_)
+            SDL_SetAudioStreamGain(stream_, gain);
+    }
+
+    void close()
+    {
+        // Сначала поток SDL: после SDL_DestroyAudioStream feed() больше не вызывается
+        if (stream_)
+        {
+            SDL_DestroyAudioStream(stream_);
+            stream_ = nullptr;
+        }
+        stop_ = true;
+        wake_.notify_one();
+        if (worker_.joinable())
+            worker_.join();
+        if (decoder_)
+        {
+            MIX_DestroyAudioDecoder(decoder_);
+            decoder_ = nullptr;
+        }
+        file_.close();
+        ring_.clear();
+    }
+
+    bool isOpen() const
+    {
+        return stream_ != nullptr;
+    }
+
+private:
+    IO::MappedFile file_;
+    MIX_AudioDecoder *decoder_ = nullptr;
+    SDL_AudioSpec spec_{};
+    SDL_AudioStream *stream_ = nullptr;
+    bool loop_ = true;
+
+    // Кольцо на одного писателя (decodeLoop) и одного читателя (feed): head_ и tail_ только растут
+    std::vector<unsigned char> ring_;
+    std::atomic<std::size_t> head_ = 0;
+    std::atomic<std::size_t> tail_ = 0;
+
+    std::thread worker_;
+    std::atomic<bool> stop_ = true;
+    std::mutex wakeMutex_;
+    std::condition_variable wake_;
+
+private:
+    // Декодер читает из отображённого файла; для повтора трека создаётся заново
+    bool openDecoder()
+    {
+        if (decoder_)
+            MIX_DestroyAudioDecoder(decoder_);
+        SDL_IOStream *io = SDL_IOFromConstMem(file_.view().data(), file_.size());
+        decoder_ = io ? MIX_CreateAudioDecoder_IO(io, true, 0) : nullptr;
+        return decoder_ != nullptr;
+    }
+
+    enum class Step : unsigned char
+    {
+        Decoded,
+        Full,    // в кольце нет места под кусок
+        Finished // конец файла без повтора или ошибка
+    };
+
+    Step decodeStep(std::vector<unsigned char> &chunk)
+    {
+        const std::size_t used = head_.load(std::memory_order_relaxed) - tail_.load(std::memory_order_acquire);
+        if (ring_.size() - used < chunk.size())
+            return Step::Full;
+        const int decoded = MIX_DecodeAudio(decoder_, chunk.data(), static_cast<int>(chunk.size()), &spec_);
+        if (decoded > 0)
+        {
+            write(chunk.data(), static_cast<std::size_t>(decoded));
+            return Step::Decoded;
+        }
+        if (decoded < 0)
+            SDL_Log("MusicStream: %s", SDL_GetError());
+        return decoded == 0 && loop_ && openDecoder() ? Step::Decoded : Step::Finished;
+    }
+
+    void decodeLoop()
+    {
+        std::vector<unsigned char> chunk(chunkBytes);
+        while (!stop_)
+        {
+            const Step step = decodeStep(chunk);
+            if (step == Step::Finished)
+                return;
+            if (step == Step::Full)
+            {
+                // feed() будит, когда кольцо опустеет наполовину; таймаут - на случай пропущенного сигнала
+                std::unique_lock lock(wakeMutex_);
+                wake_.wait_for(lock, std::chrono::milliseconds(bufferMs / 4));
+            }
+        }
+    }
+
+    void write(const unsigned char *data, const std::size_t size)
+    {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        const std::size_t pos = head % ring_.size();
+        const std::size_t first = std::min(size, ring_.size() - pos);
+        std::copy_n(data, first, ring_.begin() + pos);
+        std::copy_n(data + first, size - first, ring_.begin());
+        head_.store(head + size, std::memory_order_release);
+    }
+
+    // Поток звука SDL: отдаёт сколько есть; при нехватке - тишина вместо ожидания декодера
+    static void SDLCALL feed(void *userdata, SDL_AudioStream *stream, int additionalAmount, int)
+    {
+        MusicStream &self = *static_cast<MusicStream *>(userdata);
+        const std::size_t frame = static_cast<std::size_t>(SDL_AUDIO_FRAMESIZE(self.spec_));
+        const std::size_t tail = self.tail_.load(std::memory_order_relaxed);
+        const std::size_t available = self.head_.load(std::memory_order_acquire) - tail;
+        std::size_t size = std::min(available, static_cast<std::size_t>(std::max(additionalAmount, 0)));
+        size -= size % frame;
+
+        const std::size_t pos = tail % self.ring_.size();
+        const std::size_t first = std::min(size, self.ring_.size() - pos);
+        if (first > 0)
+            SDL_PutAudioStreamData(stream, self.ring_.data() + pos, static_cast<int>(first));
+        if (size > first)
+            SDL_PutAudioStreamData(stream, self.ring_.data(), static_cast<int>(size - first));
+        self.tail_.store(tail + size, std::memory_order_release);
+
+        if (available - size < self.ring_.size() / 2)
+            self.wake_.notify_one();
+    }
+};
+
+} // namespace audio
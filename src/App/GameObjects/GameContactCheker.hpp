@@ -1,16 +1,24 @@
 #pragma once
 
-#include <App/AppEvents.hpp>
-#include <SDLWrapper/EventRegistrator.hpp>
+#include <algorithm>
+#include <utility>
+#include <vector>
 
 #include <box2d/b2_body.h>
 #include <box2d/b2_world_callbacks.h>
 
+#include <Core/Types.hpp>
+
 #include "GameObject.hpp"
 
 namespace objects
 {
 
+// Пара объектов одного уровня, коснувшихся друг друга. first < second.
+using MergePair = std::pair<ObjectHandle, ObjectHandle>;
+
+// Собирает пары для слияния во время b2World::Step.
+// Пары разбираются пакетом после шага, через takePairs().
 class GameContactCheker : public b2ContactListener
 {
 public:
@@ -27,14 +35,33 @@ public:
         GameObject *objB = reinterpret_cast<GameObject *>(bodyB->GetUserData().pointer);
         if (!objA || !objB || !objA->isEnabled() || !objB->isEnabled() || objA->getBody()->GetType() == b2_staticBody || objB->getBody()->GetType() == b2_staticBody)
             return;
-        if (objA->getLevel() == objB->getLevel())
-            sdl3::EventRegistrator::createEventCorrect(app::AppEventsType::COLLISION, objA->getLevel(), objA->getID(), objB->getID());
+        if (objA->getLevel() != objB->getLevel())
+            return;
+        const ObjectHandle idA = objA->getHandle();
+        const ObjectHandle idB = objB->getHandle();
+        pairs_.emplace_back(std::min(idA, idB), std::max(idA, idB));
     }
 
     void EndContact(b2Contact *contact) override
     {
         // контакт закончился
     }
+
+    // Пары, накопленные за шаг: без повторов (у тела может быть много фикстур),
+    // отсортированы по номерам пула для детерминированного порядка слияний.
+    // Ссылка действительна до следующего шага мира.
+    const std::vector<MergePair> &takePairs()
+    {
+        std::sort(pairs_.begin(), pairs_.end());
+        pairs_.erase(std::unique(pairs_.begin(), pairs_.end()), pairs_.end());
+        taken_.swap(pairs_);
+        pairs_.clear();
+        return taken_;
+    }
+
+private:
+    std::vector<MergePair> pairs_;
+    std::vector<MergePair> taken_;
 };
 
-} // namespace objects
\ No newline at end of file
+} // namespace objects
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <compare>
+#include <cstdint>
+#include <limits>
+
 #include <Core/Types.hpp>
 
 #include <App/Physics/Entity.hpp>
@@ -7,6 +11,23 @@
 namespace objects
 {
 
+// Место объекта в GameObjectPool. Поколение растёт при каждом освобождении места,
+// поэтому номер удалённого объекта не найдёт объект, занявший его место позже.
+struct ObjectHandle
+{
+    inline static constexpr const std::uint32_t invalid = std::numeric_limits<std::uint32_t>::max();
+
+    std::uint32_t index = invalid;
+    std::uint32_t generation = 0;
+
+    bool valid() const
+    {
+        return index != invalid;
+    }
+
+    auto operator<=>(const ObjectHandle &) const = default;
+};
+
 class GameObject : public physics::Entity
 {
 public:
@@ -26,7 +47,18 @@ public:
         return points_;
     }
 
+    // Выдаёт GameObjectPool при добавлении
+    ObjectHandle getHandle() const
+    {
+        return handle_;
+    }
+    void setHandle(const ObjectHandle handle)
+    {
+        handle_ = handle;
+    }
+
 private:
+    ObjectHandle handle_;
     IDType level_ = 0;
     int points_ = 0;
 };
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <Core/Types.hpp>
+
+#include "GameObject.hpp"
+
+namespace objects
+{
+
+// Плотный массив GameObject + таблица мест (slot map) с поколениями.
+// push выдаёт объекту ObjectHandle; find и erase по устаревшему номеру ничего не находят.
+// Поиск и удаление за O(1): удаление переносит последний объект на место удалённого.
+// Порядок объектов при удалении не сохраняется.
+class GameObjectPool
+{
+public:
+    using iterator = std::vector<GameObject>::iterator;
+    using const_iterator = std::vector<GameObject>::const_iterator;
+
+public:
+    GameObject &push(GameObject &&obj)
+    {
+        std::uint32_t slot = 0;
+        if (!free_.empty())
+        {
+            slot = free_.back();
+            free_.pop_back();
+        }
+        else
+        {
+            slot = static_cast<std::uint32_t>(slots_.size());
+            slots_.emplace_back();
+        }
+        slots_[slot].dense = static_cast<std::uint32_t>(objects_.size());
+        obj.setHandle({slot, slots_[slot].generation});
+        objects_.push_back(std::move(obj));
+        return objects_.back();
+    }
+
+    GameObject *find(const ObjectHandle handle)
+    {
+        const std::uint32_t ind = denseOf(handle);
+        return ind == npos ? nullptr : &objects_[ind];
+    }
+    const GameObject *find(const ObjectHandle handle) const
+    {
+        const std::uint32_t ind = denseOf(handle);
+        return ind == npos ? nullptr : &objects_[ind];
+    }
+
+    bool erase(const ObjectHandle handle)
+    {
+        const std::uint32_t ind = denseOf(handle);
+        if (ind == npos)
+            return false;
+        eraseAt(ind);
+        return true;
+    }
+
+    // Удаляет объекты, для которых pred(obj) == true. Возвращает количество удалённых.
+    template <typename Pred>
+    std::size_t eraseIf(Pred &&pred)
+    {
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < objects_.size();)
+        {
+            if (pred(objects_[i]))
+            {
+                eraseAt(i);
+                ++count;
+            }
+            else
+                ++i;
+        }
+        return count;
+    }
+
+    void clear()
+    {
+        for (const GameObject &obj : objects_)
+            freeSlot(obj.getHandle().index);
+        objects_.clear();
+    }
+
+    void reserve(const std::size_t count)
+    {
+        objects_.reserve(count);
+    }
+
+    // GET METHODS
+
+    std::size_t size() const
+    {
+        return objects_.size();
+    }
+    bool empty() const
+    {
+        return objects_.empty();
+    }
+
+    GameObject &back()
+    {
+        return objects_.back();
+    }
+
+    const std::vector<GameObject> &getAll() const
+    {
+        return objects_;
+    }
+
+    iterator begin()
+    {
+        return objects_.begin();
+    }
+    iterator end()
+    {
+        return objects_.end();
+    }
+    const_iterator begin() const
+    {
+        return objects_.begin();
+    }
+    const_iterator end() const
+    {
+        return objects_.end();
+    }
+
+private:
+    inline static constexpr const std::uint32_t npos = UINT32_MAX;
+
+    struct Slot
+    {
+        std::uint32_t dense = npos; // индекс в objects_, npos - место свободно
+        std::uint32_t generation = 0;
+    };
+
+    std::vector<GameObject> objects_;
+    std::vector<Slot> slots_;
+    std::vector<std::uint32_t> free_;
+
+private:
+    std::uint32_t denseOf(const ObjectHandle handle) const
+    {
+        if (handle.index >= slots_.size() || slots_[handle.index].generation != handle.generation)
+            return npos;
+        return slots_[handle.index].dense;
+    }
+
+    void freeSlot(const std::uint32_t slot)
+    {
+        slots_[slot].dense = npos;
+        ++slots_[slot].generation;
+        free_.push_back(slot);
+    }
+
+    void eraseAt(const std::size_t ind)
+    {
+        freeSlot(objects_[ind].getHandle().index);
+        const std::size_t last = objects_.size() - 1;
+        if (ind != last)
+        {
+            // Перемещение перепривязывает user data тела Box2D к новому адресу
+            objects_[ind] = std::move(objects_[last]);
+            slots_[objects_[ind].getHandle().index].dense = static_cast<std::uint32_t>(ind);
+        }
+        objects_.pop_back();
+    }
+};
+
+} // namespace objects
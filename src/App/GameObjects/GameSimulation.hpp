@@ -0,0 +1,304 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <SDL3/SDL_log.h>
+#include <SDLWrapper/Math/Colors.hpp>
+#include <SDLWrapper/Names.hpp>
+
+#include <box2d/box2d.h>
+
+#include <App/Physics/Config.hpp>
+#include <App/Physics/EntityFactory.hpp>
+#include <App/Render/MeshFactory.hpp>
+#include <App/Resources/ObjectFactory.hpp>
+#include <App/Resources/Types.hpp>
+#include <Core/Profiler.hpp>
+#include <Core/Random.hpp>
+#include <Core/Types.hpp>
+
+#include "GameContactCheker.hpp"
+#include "GameObject.hpp"
+#include "GameObjectPool.hpp"
+
+namespace objects
+{
+
+// Результат слияния двух объектов
+struct MergeResult
+{
+    IDType mergedId = 0;
+    const resources::ObjectDef *def = nullptr;
+    int points = 0;
+};
+
+// Физический мир и правила игры (сброс, слияние, падение за стакан) без окна, рендера и звука.
+// Используется и GameScene, и HeadlessGameSim.
+class GameSimulation
+{
+public:
+    inline static constexpr const float fallenY = 2000.f;
+    inline static constexpr const int velocityIterations = 8;
+    inline static constexpr const int positionIterations = 3;
+
+public:
+    GameSimulation(resources::ObjectFactory &factory) : factory_(factory)
+    {
+        world_.SetContactListener(&contactCheker_);
+    }
+    GameSimulation(const GameSimulation &) = delete;
+    GameSimulation &operator=(const GameSimulation &) = delete;
+
+    void setSettings(const resources::PackageSettings &settings)
+    {
+        settings_ = settings;
+    }
+    const resources::PackageSettings &getSettings() const
+    {
+        return settings_;
+    }
+
+    void setFixedTimeStep(const float dt)
+    {
+        if (dt > 0.f)
+            fixedDt_ = dt;
+    }
+    float getFixedTimeStep() const
+    {
+        return fixedDt_;
+    }
+    void setMaxSubSteps(const int count)
+    {
+        maxSubSteps_ = count > 0 ? count : 1;
+    }
+
+    void setSeed(const unsigned long long seed)
+    {
+        random_.setSeed(seed);
+    }
+
+    void generateGlass(const sdl3::Vector2i logicSize, const sdl3::Vector2f glassSize, const float thikness)
+    {
+        glass_.clear();
+
+        float yPos = logicSize.y;
+
+        glass_.push_back(physics::EntityFactory::createRectangle(world_, {logicSize.x / 2.f, yPos}, {glassSize.x, thikness}, sdl3::Colors::Black, nullptr, b2BodyType::b2_staticBody));
+        glass_.push_back(physics::EntityFactory::createRectangle(world_, {logicSize.x / 2.f - glassSize.x / 2.f, yPos - glassSize.y / 2.f}, {thikness, glassSize.y}, sdl3::Colors::Black, nullptr, b2BodyType::b2_staticBody));
+        glass_.push_back(physics::EntityFactory::createRectangle(world_, {logicSize.x / 2.f + glassSize.x / 2.f, yPos - glassSize.y / 2.f}, {thikness, glassSize.y}, sdl3::Colors::Black, nullptr, b2BodyType::b2_staticBody));
+
+        startPoss_ =
+            {
+                logicSize.x / 2.f,
+                (yPos - (glassSize.y)) / 2.f};
+        glassInner_ =
+            {
+                logicSize.x / 2.f - glassSize.x / 2.f + thikness / 2.f,
+                logicSize.x / 2.f + glassSize.x / 2.f - thikness / 2.f};
+
+        glassMeshes_ = {
+            render::MeshFactory::makeRectangleMesh({glassSize.x, thikness}),
+            render::MeshFactory::makeRectangleMesh({thikness, glassSize.y})};
+        glass_[0].setSprite({&glassMeshes_[0], nullptr, sdl3::Colors::Black});
+        glass_[1].setSprite({&glassMeshes_[1], nullptr, sdl3::Colors::Black});
+        glass_[2].setSprite({&glassMeshes_[1], nullptr, sdl3::Colors::Black});
+
+        // Статические тела не просыпаются: синхронизируем фигуры один раз
+        for (physics::Entity &wall : glass_)
+            wall.syncShape();
+    }
+
+    void clear()
+    {
+        preview_.reset();
+        objects_.clear();
+        accumulator_ = 0.f;
+    }
+
+    // Шаг мира и слияние всех пар, коснувшихся за этот шаг.
+    // onMerge(const MergeResult &) вызывается для каждого слияния.
+    template <typename Func>
+    void step(const float dt, Func &&onMerge)
+    {
+        {
+            CORE_PROFILE_ZONE(Physics);
+            world_.Step(dt, velocityIterations, positionIterations);
+        }
+        CORE_PROFILE_ZONE(Merges);
+        for (const auto &[idA, idB] : contactCheker_.takePairs())
+            if (const auto merged = merge(idA, idB))
+                onMerge(*merged);
+    }
+
+    // Шаги фиксированной длины за прошедшее время кадра, не более maxSubSteps.
+    // Остаток времени задаёт интерполяцию отрисовки объектов. Возвращает число шагов.
+    template <typename Func>
+    int advance(const float frameDt, Func &&onMerge)
+    {
+        accumulator_ += frameDt;
+        int steps = 0;
+        while (accumulator_ >= fixedDt_ && steps < maxSubSteps_)
+        {
+            for (GameObject &obj : objects_)
+                if (obj.getBody()->IsAwake())
+                    obj.savePrevious();
+            step(fixedDt_, onMerge);
+            accumulator_ -= fixedDt_;
+            ++steps;
+        }
+        // После зависания не догоняем: лишнее время отбрасывается
+        if (accumulator_ >= fixedDt_)
+            accumulator_ = std::fmod(accumulator_, fixedDt_);
+
+        const float alpha = accumulator_ / fixedDt_;
+        for (GameObject &obj : objects_)
+        {
+            obj.setRenderAlpha(alpha);
+            obj.syncShape();
+        }
+        return steps;
+    }
+
+    // GET METHODS
+
+    const sdl3::Vector2f &getStartPosition() const
+    {
+        return startPoss_;
+    }
+    // Внутренние границы стакана по x
+    const sdl3::Vector2f &getGlassInner() const
+    {
+        return glassInner_;
+    }
+    const std::vector<physics::Entity> &getGlass() const
+    {
+        return glass_;
+    }
+    const GameObjectPool &getObjects() const
+    {
+        return objects_;
+    }
+    const GameObject *getPreview() const
+    {
+        return preview_.get();
+    }
+    const b2World &getWorld() const
+    {
+        return world_;
+    }
+
+    // Временный объект
+
+    // Создаёт выключенный объект случайного уровня над стаканом.
+    // false, если в пакете нет объекта нужного уровня или его не удалось создать.
+    bool createPreview()
+    {
+        IDType level = random_(settings_.levelRange.x, settings_.levelRange.y);
+        auto idpt = factory_.getIdByLevel(level);
+        if (!idpt.has_value())
+        {
+            SDL_Log("Error! Not found object by level %d\n", static_cast<int>(level));
+            return false;
+        }
+        auto created = factory_.createById(world_, idpt.value(), {startPoss_.x, -startPoss_.y});
+        if (!created)
+        {
+            SDL_Log("Error! Failed to create object %d\n", static_cast<int>(idpt.value()));
+            return false;
+        }
+
+        preview_ = std::make_unique<GameObject>(std::move(*created));
+        preview_->setEnabled(false);
+        preview_->syncShape();
+        return true;
+    }
+
+    void movePreview(const float xPos)
+    {
+        if (preview_)
+            preview_->setPosition({xPos, startPoss_.y});
+    }
+
+    // Бросает временный объект в стакан. Возвращает брошенный объект.
+    const GameObject *drop(const float xPos)
+    {
+        if (!preview_)
+            return nullptr;
+        preview_->setPosition({xPos, startPoss_.y});
+        preview_->setEnabled(true);
+        GameObject &dropped = objects_.push(std::move(*preview_.get()));
+        preview_.reset();
+        return &dropped;
+    }
+
+    // Правила
+
+    std::optional<MergeResult> merge(const ObjectHandle idA, const ObjectHandle idB)
+    {
+        const GameObject *obj1 = objects_.find(idA);
+        const GameObject *obj2 = objects_.find(idB);
+        if (!obj1 || !obj2 || obj1 == obj2)
+            return std::nullopt;
+
+        const auto mergedIdOpt = factory_.getMergeResultId(obj1->getLevel(), obj2->getLevel());
+        if (!mergedIdOpt)
+            return std::nullopt;
+
+        MergeResult res;
+        res.mergedId = *mergedIdOpt;
+        res.def = factory_.getDefById(res.mergedId);
+
+        sdl3::Vector2f pos = (obj1->getShape().getPosition() + obj2->getShape().getPosition()) / 2.f;
+
+        // После erase указатели obj1/obj2 недействительны
+        objects_.erase(idA);
+        objects_.erase(idB);
+
+        auto created = factory_.create(world_, res.def, pos);
+        if (!created)
+            return res;
+
+        res.points = objects_.push(std::move(*created)).getPoints();
+        return res;
+    }
+
+    // Удаляет объекты, выпавшие из стакана. onFallen(points) вызывается для каждого.
+    template <typename Func>
+    void removeFallen(Func &&onFallen)
+    {
+        objects_.eraseIf(
+            [&onFallen](const GameObject &obj)
+            {
+                if (obj.getPosition().y <= fallenY)
+                    return false;
+                onFallen(obj.getPoints());
+                return true;
+            });
+    }
+
+private:
+    b2World world_{b2Vec2(0.0f, 9.81f)};
+    GameContactCheker contactCheker_;
+    std::vector<physics::Entity> glass_;
+    // Дно и стенки
+    std::array<render::Mesh, 2> glassMeshes_;
+    GameObjectPool objects_;
+
+    resources::ObjectFactory &factory_;
+    resources::PackageSettings settings_;
+
+    std::unique_ptr<GameObject> preview_ = nullptr;
+    sdl3::Vector2f startPoss_;
+    sdl3::Vector2f glassInner_;
+    core::Random<IDType> random_;
+
+    float fixedDt_ = physics::Config::fixedTimeStep;
+    int maxSubSteps_ = physics::Config::maxSubSteps;
+    float accumulator_ = 0.f;
+};
+
+} // namespace objects
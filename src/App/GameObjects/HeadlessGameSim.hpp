@@ -0,0 +1,222 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_timer.h>
+#include <SDLWrapper/Clock.hpp>
+#include <SDLWrapper/Names.hpp>
+
+#include <App/Resources/ObjectFactory.hpp>
+#include <App/Resources/PackageContainer.hpp>
+#include <Core/Managers/AudioManager.hpp>
+#include <Core/Managers/TextureManager.hpp>
+#include <Core/Random.hpp>
+
+#include "GameSimulation.hpp"
+
+namespace objects
+{
+
+struct HeadlessSimSettings
+{
+    std::string packName;
+    unsigned long long seed = 1;
+    unsigned int drops = 1000;
+    float dt = physics::Config::fixedTimeStep;
+    // <= 0 - интервал из настроек пакета
+    float dropIntervalS = 0.f;
+    sdl3::Vector2i logicSize = {576, 1024};
+    physics::EntityFactory::EllipseBuilder ellipse = physics::EntityFactory::EllipseBuilder::Adaptive;
+};
+
+inline const char *ellipseBuilderName(const physics::EntityFactory::EllipseBuilder builder)
+{
+    return builder == physics::EntityFactory::EllipseBuilder::Sectors ? "sectors" : "adaptive";
+}
+
+// Среднее время кадра (шаг + слияния + удаление) при заданном числе объектов
+struct FrameTimeBucket
+{
+    std::uint64_t totalNS = 0;
+    std::size_t frames = 0;
+
+    float averageUS() const
+    {
+        return frames ? static_cast<float>(totalNS) / frames / 1000.f : 0.f;
+    }
+};
+
+struct HeadlessSimReport
+{
+    inline static constexpr const std::size_t objectsPerBucket = 10;
+
+    unsigned int drops = 0;
+    unsigned int merges = 0;
+    unsigned int fallen = 0;
+    unsigned int gameOvers = 0;
+    std::size_t steps = 0;
+    std::size_t maxObjects = 0;
+    std::size_t maxContacts = 0;
+    std::uint64_t contactsSum = 0;
+    long long points = 0;
+    float wallSeconds = 0.f;
+    std::vector<FrameTimeBucket> frameTimes;
+
+    float dropsPerSecond() const
+    {
+        return wallSeconds > 0.f ? drops / wallSeconds : 0.f;
+    }
+    float stepsPerSecond() const
+    {
+        return wallSeconds > 0.f ? steps / wallSeconds : 0.f;
+    }
+    float averageContacts() const
+    {
+        return steps ? static_cast<float>(contactsSum) / steps : 0.f;
+    }
+};
+
+// Детерминированная симуляция игры без окна, рендера и звука.
+// Шаг фиксированный, уровни и точки сброса берутся из core::Random с заданным seed.
+class HeadlessGameSim
+{
+public:
+    HeadlessGameSim(std::filesystem::path objectsRoot)
+        : packages_(std::move(objectsRoot), textures_, audios_), factory_(packages_), sim_(factory_)
+    {
+        packages_.setLoadMedia(false);
+    }
+
+    bool load(const std::string &packName)
+    {
+        if (!factory_.loadPack(packName))
+            return false;
+        const resources::ObjectPack *pack = packages_.getPack(packName);
+        if (!pack)
+            return false;
+        sim_.setSettings(pack->getSetings());
+        sim_.generateGlass(logicSize_, {(float)logicSize_.x, (float)logicSize_.y * 0.75f}, 30);
+        return true;
+    }
+
+    HeadlessSimReport run(const HeadlessSimSettings &setts)
+    {
+        HeadlessSimReport report;
+        if (logicSize_.x != setts.logicSize.x || logicSize_.y != setts.logicSize.y)
+        {
+            logicSize_ = setts.logicSize;
+            sim_.generateGlass(logicSize_, {(float)logicSize_.x, (float)logicSize_.y * 0.75f}, 30);
+        }
+
+        sim_.clear();
+        if (resources::ObjectPack *pack = packages_.getPack(setts.packName))
+            pack->rebuildEllipseBodies(setts.ellipse);
+        sim_.setSeed(setts.seed);
+        xRandom_.setSeed(setts.seed);
+
+        const resources::PackageSettings &packSetts = sim_.getSettings();
+        const float dropInterval = setts.dropIntervalS > 0.f ? setts.dropIntervalS : packSetts.summonTimeStepS;
+        const sdl3::Vector2f inner = sim_.getGlassInner();
+
+        unsigned int deaths = 0;
+        float sinceDrop = dropInterval;
+
+        sdl3::Clock clock;
+        clock.start();
+        while (report.drops < setts.drops)
+        {
+            if (sinceDrop >= dropInterval)
+            {
+                if (!sim_.getPreview() && !sim_.createPreview())
+                    break;
+                const GameObject *dropped = sim_.drop(xRandom_(inner.x, inner.y));
+                if (!dropped)
+                    break;
+                report.points += dropped->getPoints();
+                ++report.drops;
+                sinceDrop = 0.f;
+            }
+
+            const std::size_t objectsCount = sim_.getObjects().size();
+            const Uint64 frameStart = SDL_GetTicksNS();
+
+            sim_.step(setts.dt,
+                      [&report](const MergeResult &merged)
+                      {
+                          ++report.merges;
+                          report.points += merged.points;
+                      });
+            sinceDrop += setts.dt;
+            ++report.steps;
+
+            sim_.removeFallen(
+                [&](const int points)
+                {
+                    report.points -= points;
+                    ++report.fallen;
+                    ++deaths;
+                });
+            if (deaths >= packSetts.deathCount)
+            {
+                ++report.gameOvers;
+                deaths = 0;
+                sim_.clear();
+            }
+            addFrameTime(report, objectsCount, SDL_GetTicksNS() - frameStart);
+            const std::size_t contacts = static_cast<std::size_t>(sim_.getWorld().GetContactCount());
+            report.contactsSum += contacts;
+            report.maxContacts = std::max(report.maxContacts, contacts);
+            report.maxObjects = std::max(report.maxObjects, sim_.getObjects().size());
+        }
+        report.wallSeconds = clock.elapsedTimeS();
+        return report;
+    }
+
+    const GameSimulation &getSimulation() const
+    {
+        return sim_;
+    }
+
+private:
+    core::managers::TextureManager textures_;
+    core::managers::AudioManager audios_;
+    resources::PackageContainer packages_;
+    resources::ObjectFactory factory_;
+    GameSimulation sim_;
+
+    core::Random<float> xRandom_;
+    sdl3::Vector2i logicSize_ = {576, 1024};
+
+private:
+    static void addFrameTime(HeadlessSimReport &report, const std::size_t objectsCount, const Uint64 ns)
+    {
+        const std::size_t bucket = objectsCount / HeadlessSimReport::objectsPerBucket;
+        if (bucket >= report.frameTimes.size())
+            report.frameTimes.resize(bucket + 1);
+        report.frameTimes[bucket].totalNS += ns;
+        ++report.frameTimes[bucket].frames;
+    }
+};
+
+inline void logReport(const HeadlessSimSettings &setts, const HeadlessSimReport &report)
+{
+    SDL_Log("Headless: pack=%s ellipse=%s seed=%llu drops=%u merges=%u fallen=%u gameOvers=%u steps=%zu maxObjects=%zu points=%lld",
+            setts.packName.c_str(), ellipseBuilderName(setts.ellipse), setts.seed, report.drops, report.merges, report.fallen, report.gameOvers, report.steps, report.maxObjects, report.points);
+    SDL_Log("Headless: %.3f s, %.1f drops/s, %.1f steps/s", report.wallSeconds, report.dropsPerSecond(), report.stepsPerSecond());
+    SDL_Log("Headless: contacts avg %.1f, max %zu", report.averageContacts(), report.maxContacts);
+    for (std::size_t i = 0; i < report.frameTimes.size(); ++i)
+    {
+        const FrameTimeBucket &bucket = report.frameTimes[i];
+        if (bucket.frames == 0)
+            continue;
+        SDL_Log("Headless: objects %zu-%zu: %.1f us/frame (%zu frames)",
+                i * HeadlessSimReport::objectsPerBucket, (i + 1) * HeadlessSimReport::objectsPerBucket - 1, bucket.averageUS(), bucket.frames);
+    }
+}
+
+} // namespace objects
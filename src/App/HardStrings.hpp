@@ -7,6 +7,9 @@ namespace names
 {
 constexpr const std::string_view mainIco = "ico.png";
 constexpr const std::string_view statisticFile = "stat.xml";
+// Индекс пакетов и атлас миниатюр (рабочая папка, пересобираются при изменении пакетов)
+constexpr const std::string_view packIndexFile = "pack-index.xml";
+constexpr const std::string_view packThumbnailsFile = "pack-thumbnails.png";
 constexpr const std::string_view windowName = "Объединялы";
 
 } // namespace names
@@ -15,6 +18,8 @@ namespace assets
 {
 constexpr const std::string_view packages = "objects";
 constexpr const std::string_view packagConf = "config.xml";
+// Собранный упаковщиком пакет (UnionsPacker), имеет приоритет над config.xml
+constexpr const std::string_view packagBinary = "pack.upack";
 constexpr const std::string_view fontPath = "fonts/fonts.txt";
 
 } // namespace assets
@@ -45,6 +50,7 @@ inline const std::string resumeWinB = "resume-win-b";
 inline const std::string pauseOverlayId = "pause-overlay";
 inline const std::string gameOverOverlayId = "gameover-overlay";
 inline const std::string winOverOverlayId = "win-overlay";
+inline const std::string loadingOverlayId = "loading-overlay";
 
 inline const std::string openClass = "open";
 inline const std::string restartClass = "restart";
@@ -53,6 +59,7 @@ inline const std::string resumeClass = "resume";
 
 inline const std::string deathLabel = "death";
 inline const std::string maxDeathLabel = "maxdeath";
+inline const std::string loadingLabel = "loading";
 
 } // namespace ui::gameMenu
 
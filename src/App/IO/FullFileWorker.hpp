@@ -8,6 +8,8 @@
 #include <SDL3/SDL_log.h>
 #include <SDLWrapper/FileWorker.hpp>
 
+#include "MappedFile.hpp"
+
 namespace IO
 {
 
@@ -61,9 +63,9 @@ inline bool createAndMove(const std::filesystem::path &existing, const std::file
 
 inline bool isValidXmlFile(const std::filesystem::path& path)
 {
-    std::string file = readAllFile(path);
+    MappedFile file(path);
     pugi::xml_document doc;
-    return doc.load_string(file.c_str());
+    return !file.empty() && doc.load_buffer_inplace(file.mutableData(), file.size());
 }
 
 } // namespace IO
\ No newline at end of file
@@ -17,8 +17,10 @@ inline bool readAllGameStatistic(statistic::AllGameStatistic &stat, std::string&
 {
     stat.clear();
 
+    // Разбор прямо в отображённом файле, без копий; file должен пережить doc
+    MappedFile file(path);
     pugi::xml_document doc;
-    if (auto res = doc.load_string(IO::readAllFile(path).c_str()); !res)
+    if (auto res = doc.load_buffer_inplace(file.mutableData(), file.size()); !res)
     {
         SDL_Log("GameStatisticReader: xml parse error at offset %u", (unsigned)res.offset);
         return false;
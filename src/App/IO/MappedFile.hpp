@@ -0,0 +1,182 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+#include <utility>
+
+#include <SDL3/SDL_iostream.h>
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_stdinc.h>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#define IO_MAPPED_FILE_POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace IO
+{
+
+// Файл, отображённый в память (mmap / MapViewOfFile) без копии в куче.
+// Отображение частное (copy-on-write): буфер можно менять на месте (pugi load_buffer_inplace),
+// файл на диске не меняется. Если отобразить нельзя (ассеты внутри APK на Android) -
+// файл читается целиком через SDL_IOStream.
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::filesystem::path &path)
+    {
+        open(path);
+    }
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    MappedFile(MappedFile &&other) noexcept
+    {
+        swap(other);
+    }
+    MappedFile &operator=(MappedFile &&other) noexcept
+    {
+        if (this != &other)
+        {
+            close();
+            swap(other);
+        }
+        return *this;
+    }
+    ~MappedFile()
+    {
+        close();
+    }
+
+    // false - файла нет или он пустой (без сообщения в лог, отсутствие файла бывает нормой)
+    bool open(const std::filesystem::path &path)
+    {
+        close();
+        return map(path) || load(path);
+    }
+
+    void close()
+    {
+        if (!data_)
+            return;
+#if defined(_WIN32)
+        if (mapped_)
+            UnmapViewOfFile(data_);
+#elif defined(IO_MAPPED_FILE_POSIX)
+        if (mapped_)
+            munmap(data_, size_);
+#endif
+        if (!mapped_)
+            SDL_free(data_);
+        data_ = nullptr;
+        size_ = 0;
+        mapped_ = false;
+    }
+
+    bool empty() const
+    {
+        return size_ == 0;
+    }
+    std::size_t size() const
+    {
+        return size_;
+    }
+    std::string_view view() const
+    {
+        return {data_, size_};
+    }
+    // Для разбора на месте; изменения видит только этот процесс
+    char *mutableData()
+    {
+        return data_;
+    }
+    bool isMapped() const
+    {
+        return mapped_;
+    }
+
+private:
+    char *data_ = nullptr;
+    std::size_t size_ = 0;
+    bool mapped_ = false;
+
+private:
+    void swap(MappedFile &other) noexcept
+    {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(mapped_, other.mapped_);
+    }
+
+    bool map(const std::filesystem::path &path)
+    {
+#if defined(_WIN32)
+        HANDLE file = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+        LARGE_INTEGER size{};
+        HANDLE mapping = nullptr;
+        if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+            mapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (!mapping)
+            return false;
+        void *view = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+        CloseHandle(mapping);
+        if (!view)
+            return false;
+        data_ = static_cast<char *>(view);
+        size_ = static_cast<std::size_t>(size.QuadPart);
+        mapped_ = true;
+        return true;
+#elif defined(IO_MAPPED_FILE_POSIX)
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+        struct stat st{};
+        void *view = MAP_FAILED;
+        if (fstat(fd, &st) == 0 && st.st_size > 0)
+            view = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (view == MAP_FAILED)
+            return false;
+        data_ = static_cast<char *>(view);
+        size_ = static_cast<std::size_t>(st.st_size);
+        mapped_ = true;
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    bool load(const std::filesystem::path &path)
+    {
+        std::size_t size = 0;
+        void *data = SDL_LoadFile(path.string().c_str(), &size);
+        if (!data)
+            return false;
+        if (size == 0)
+        {
+            SDL_free(data);
+            return false;
+        }
+        data_ = static_cast<char *>(data);
+        size_ = size;
+        mapped_ = false;
+        return true;
+    }
+};
+
+} // namespace IO
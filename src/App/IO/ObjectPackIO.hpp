@@ -1,12 +1,18 @@
 #pragma once
 
+#include <algorithm>
 #include <filesystem>
+#include <utility>
+#include <vector>
 
 #include <App/HardStrings.hpp>
+#include <App/Physics/EntityFactory.hpp>
+#include <App/Render/MeshFactory.hpp>
 #include <App/Resources/ObjectPack.hpp>
 #include <string>
 
 #include "FullFileWorker.hpp"
+#include "MappedFile.hpp"
 #include "Resources/Types.hpp"
 
 namespace IO
@@ -82,6 +88,40 @@ inline bool parseForm(const pugi::xml_node &form, resources::ObjectFormDef &out)
     }
     return false;
 }
+inline physics::BodyTemplate makeBodyTemplate(const resources::ObjectFormDef &form)
+{
+    switch (form.type)
+    {
+    case resources::ObjectFormType::Circle:
+        return physics::EntityFactory::makeCircleTemplate(form.getRadius());
+    case resources::ObjectFormType::Ellipse:
+        return physics::EntityFactory::makeEllipseTemplate(form.getRadii());
+    case resources::ObjectFormType::Polygon:
+        return physics::EntityFactory::makePolygonTemplate(form.getPolygon());
+    case resources::ObjectFormType::Rectangle:
+        return physics::EntityFactory::makeRectangleTemplate(form.getSize());
+    default:
+        return {};
+    }
+}
+
+inline render::Mesh makeMesh(const resources::ObjectFormDef &form)
+{
+    switch (form.type)
+    {
+    case resources::ObjectFormType::Circle:
+        return render::MeshFactory::makeCircleMesh(form.getRadius());
+    case resources::ObjectFormType::Ellipse:
+        return render::MeshFactory::makeEllipseMesh(form.getRadii());
+    case resources::ObjectFormType::Polygon:
+        return render::MeshFactory::makePolygonMesh(form.getPolygon());
+    case resources::ObjectFormType::Rectangle:
+        return render::MeshFactory::makeRectangleMesh(form.getSize());
+    default:
+        return {};
+    }
+}
+
 inline bool parseSettings(const pugi::xml_node &settings, resources::PackageSettings &setts)
 {
     if (!settings)
@@ -115,6 +155,26 @@ inline bool parseMusic(const pugi::xml_node &music, resources::PackageMusic &mus
     return true;
 }
 
+// Файлы пакета для загрузки: ключ в менеджере и путь
+struct PackMediaFiles
+{
+    std::vector<std::pair<std::string, std::filesystem::path>> textures;
+    std::vector<std::pair<std::string, std::filesystem::path>> audios;
+};
+
+// Ключ ресурса в менеджерах - путь относительно папки пакетов. Файл, общий для нескольких пакетов
+// ("../sounds/final-win.mp3"), получает один ключ и загружается один раз.
+inline std::string mediaKey(const std::string &packName, const std::string &fileName)
+{
+    return (std::filesystem::path(packName) / fileName).lexically_normal().generic_string();
+}
+
+// Обратно к имени файла относительно папки пакета (для записи .upack)
+inline std::string mediaFileName(const std::string &packName, const std::string &key)
+{
+    return std::filesystem::path(key).lexically_relative(packName).generic_string();
+}
+
 namespace
 {
 
@@ -123,31 +183,62 @@ struct SounReadSettings
     const std::string &packName;
     const std::string &fileName;
     const std::filesystem::path &folderPath;
+    const bool loadMedia = true;
 };
 
-std::string readSound(SounReadSettings &&setts, core::managers::AudioManager &audios, std::unordered_set<std::string> &loadedAudioKeys)
+// Ключ звука в AudioManager; файл запоминается в media, загрузка - в loadPackMedia
+std::string readSound(SounReadSettings &&setts, PackMediaFiles &media)
 {
-    if (setts.fileName.empty())
+    if (setts.fileName.empty() || !setts.loadMedia)
         return std::string();
-    const std::string audioPathKey = setts.packName + '/' + setts.fileName;
+    const std::string audioPathKey = mediaKey(setts.packName, setts.fileName);
     const std::filesystem::path audioFile = (setts.folderPath / setts.fileName).lexically_normal();
 
-    if (!audios.has(audioPathKey) && loadedAudioKeys.insert(audioPathKey).second && !audios.load(audioPathKey, audioFile))
-        return std::string();
+    if (std::none_of(media.audios.begin(), media.audios.end(), [&audioPathKey](const auto &p) { return p.first == audioPathKey; }))
+        media.audios.emplace_back(audioPathKey, audioFile);
     return audioPathKey;
 }
+
+// Фоновая музыка целиком не декодируется: в media не попадает, путь - для audio::MusicStream
+std::string readStreamedSound(SounReadSettings &&setts, std::filesystem::path &file)
+{
+    if (setts.fileName.empty() || !setts.loadMedia)
+        return std::string();
+    file = (setts.folderPath / setts.fileName).lexically_normal();
+    return mediaKey(setts.packName, setts.fileName);
+}
 } // namespace
 
-inline bool readObjectPack(resources::ObjectPack &pack, core::managers::TextureManager &textures, core::managers::AudioManager &audios, const std::string &packName, const std::filesystem::path &folderPath)
+// Текстуры объектов: в атлас пакета, если есть renderer, иначе по одной в TextureManager.
+// Атлас, уже взятый из кэша (ObjectPack::acquireAtlas), не собирается. Картинки, не попавшие в атлас, грузятся по одной.
+inline bool loadObjectTextures(resources::ObjectPack &pack, core::managers::TextureManager &textures, const std::vector<std::pair<std::string, std::filesystem::path>> &files, SDL_Renderer *atlasRenderer)
 {
-    pack.unload(textures, audios);
+    if (atlasRenderer && pack.getAtlas().pageCount() == 0)
+    {
+        render::TextureAtlas &own = pack.getOwnAtlas();
+        for (const auto &[key, file] : files)
+            own.add(key, file);
+        if (!own.build(atlasRenderer))
+            SDL_Log("Atlas of pack %s is incomplete", pack.getName().c_str());
+        pack.shareAtlas();
+    }
+    const render::TextureAtlas &atlas = pack.getAtlas();
+    for (const auto &[key, file] : files)
+        if (!atlas.find(key) && !pack.acquireTexture(textures, key) && !textures.load(key, file))
+            return false;
+    return true;
+}
 
+// Разбор config.xml: определения объектов, геометрия и ключи ресурсов. Менеджеры не трогает,
+// поэтому может выполняться в фоновом потоке. Файлы текстур и звуков складываются в media.
+// loadMedia == false - только определения объектов, без текстур и звуков (headless режим)
+// config разбирается на месте (load_buffer_inplace) и после вызова не годится для повторного разбора
+inline bool parseObjectPack(resources::ObjectPack &pack, PackMediaFiles &media, MappedFile &config, const std::string &packName, const std::filesystem::path &folderPath, const bool loadMedia = true)
+{
     pack.setPackageName(packName);
 
-    const auto configFile = folderPath / assets::packagConf;
-
     pugi::xml_document doc;
-    if (!doc.load_string(IO::readAllFile(configFile).c_str()))
+    if (config.empty() || !doc.load_buffer_inplace(config.mutableData(), config.size()))
         return false;
 
     const pugi::xml_node root = doc.child("root");
@@ -161,25 +252,11 @@ inline bool readObjectPack(resources::ObjectPack &pack, core::managers::TextureM
         return false;
 
     std::unordered_set<std::string> loadedTextureKeys;
-    std::unordered_set<std::string> loadedAudioKeys;
-
-    std::string key = readSound(
-        SounReadSettings{packName, mus.loseFile, folderPath},
-        audios, loadedAudioKeys);
-    mus.loseFile = key;
-    pack.addAudioKey(key);
-
-    key = readSound(
-        SounReadSettings{packName, mus.winFile, folderPath},
-        audios, loadedAudioKeys);
-    mus.winFile = key;
-    pack.addAudioKey(key);
-
-    key = readSound(
-        SounReadSettings{packName, mus.backgroundFile, folderPath},
-        audios, loadedAudioKeys);
-    mus.backgroundFile = key;
-    pack.addAudioKey(key);
+
+    mus.loseFile = readSound(SounReadSettings{packName, mus.loseFile, folderPath, loadMedia}, media);
+    mus.winFile = readSound(SounReadSettings{packName, mus.winFile, folderPath, loadMedia}, media);
+
+    mus.backgroundFile = readStreamedSound(SounReadSettings{packName, mus.backgroundFile, folderPath, loadMedia}, mus.backgroundPath);
 
     pack.setSettings(std::move(setts));
     pack.setMusic(std::move(mus));
@@ -204,31 +281,53 @@ inline bool readObjectPack(resources::ObjectPack &pack, core::managers::TextureM
             SDL_Log("Error of parseFiller or parseForm\ns");
             return false;
         }
+        def.body = makeBodyTemplate(def.form);
+        if (loadMedia)
+            def.mesh = makeMesh(def.form);
 
         if (def.filler.type == resources::ObjectFillerType::Texture)
         {
             const std::string fileName = def.filler.getTextureName();
-            const std::string texturePathKey = packName + '/' + fileName;
+            const std::string texturePathKey = mediaKey(packName, fileName);
             const std::filesystem::path textureFile = folderPath / fileName;
 
             def.filler.filler = texturePathKey;
-            if (!textures.has(texturePathKey) && loadedTextureKeys.insert(texturePathKey).second && !textures.load(texturePathKey, textureFile))
-                return false;
-
-            pack.addTextureKey(texturePathKey);
+            if (loadMedia && loadedTextureKeys.insert(texturePathKey).second)
+                media.textures.emplace_back(texturePathKey, textureFile);
         }
         if (!def.soundFile.empty())
-        {
-            std::string key = readSound(
-                SounReadSettings{packName, def.soundFile, folderPath},
-                audios, loadedAudioKeys);
-            pack.addAudioKey(key);
-            def.soundFile = key;
-        }
+            def.soundFile = readSound(SounReadSettings{packName, def.soundFile, folderPath, loadMedia}, media);
         pack.addObject(std::move(def));
     }
 
     return !pack.empty();
 }
 
-} // namespace IO
\ No newline at end of file
+inline bool parseObjectPack(resources::ObjectPack &pack, PackMediaFiles &media, const std::string &packName, const std::filesystem::path &folderPath, const bool loadMedia = true)
+{
+    MappedFile config(folderPath / assets::packagConf);
+    return parseObjectPack(pack, media, config, packName, folderPath, loadMedia);
+}
+
+// Загрузка файлов media в менеджеры (главный поток). Незагрузившийся звук не ошибка - его просто не будет слышно.
+inline bool loadPackMedia(resources::ObjectPack &pack, core::managers::TextureManager &textures, core::managers::AudioManager &audios, const PackMediaFiles &media, SDL_Renderer *atlasRenderer)
+{
+    for (const auto &[key, file] : media.audios)
+        if (!pack.acquireAudio(audios, key) && !audios.load(key, file))
+            SDL_Log("Failed to load sound %s", file.string().c_str());
+    return loadObjectTextures(pack, textures, media.textures, atlasRenderer);
+}
+
+// loadMedia == false - только определения объектов, без текстур и звуков (headless режим)
+// atlasRenderer != nullptr - текстуры объектов собираются в атлас (ObjectPack::getAtlas)
+inline bool readObjectPack(resources::ObjectPack &pack, core::managers::TextureManager &textures, core::managers::AudioManager &audios, const std::string &packName, const std::filesystem::path &folderPath, const bool loadMedia = true, SDL_Renderer *atlasRenderer = nullptr)
+{
+    pack.unload(textures, audios);
+
+    PackMediaFiles media;
+    if (!parseObjectPack(pack, media, packName, folderPath, loadMedia))
+        return false;
+    return loadPackMedia(pack, textures, audios, media, atlasRenderer);
+}
+
+} // namespace IO
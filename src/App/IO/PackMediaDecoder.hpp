@@ -0,0 +1,81 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_timer.h>
+#include <SDLWrapper/Audio/Audio.hpp>
+
+#include <App/Render/TextureAtlas.hpp>
+#include <Core/JobSystem.hpp>
+#include <Core/Managers/AudioManager.hpp>
+
+#include "ObjectPackIO.hpp"
+
+namespace IO
+{
+
+struct DecodedAudio
+{
+    std::string key;
+    sdl3::audio::Audio audio;
+    std::size_t bytes = 0; // оценка для бюджета AudioManager
+};
+
+// Картинки и звуки, декодированные в память; в менеджеры передаются одной пачкой
+struct DecodedPackMedia
+{
+    std::vector<std::pair<std::string, render::SharedSurface>> images;
+    std::vector<DecodedAudio> audios;
+    Uint64 longestNS = 0; // самый долгий файл
+};
+
+// Каждый файл - отдельная задача core::JobSystem; возврат после декодирования всех.
+// done - счётчик обработанных файлов (прогресс), cancelled - пропустить оставшиеся.
+inline DecodedPackMedia decodePackMedia(const PackMediaFiles &files, core::JobSystem &jobs, std::atomic<unsigned int> *done = nullptr, const std::atomic<bool> *cancelled = nullptr)
+{
+    const std::size_t imageCount = files.textures.size();
+    const std::size_t count = imageCount + files.audios.size();
+
+    std::vector<render::SharedSurface> images(imageCount);
+    std::vector<sdl3::audio::Audio> audios(files.audios.size());
+    std::vector<unsigned char> audioLoaded(files.audios.size(), 0);
+    std::vector<Uint64> durations(count, 0);
+
+    jobs.parallelFor(count,
+                     [&](const std::size_t i)
+                     {
+                         if (cancelled && cancelled->load(std::memory_order_relaxed))
+                             return;
+                         const Uint64 start = SDL_GetTicksNS();
+                         if (i < imageCount)
+                             images[i] = render::loadSurface(files.textures[i].second);
+                         else
+                         {
+                             const auto &file = files.audios[i - imageCount].second;
+                             audioLoaded[i - imageCount] = audios[i - imageCount].loadFromFile(file.string().c_str());
+                             if (!audioLoaded[i - imageCount])
+                                 SDL_Log("Failed to load sound %s", file.string().c_str());
+                         }
+                         durations[i] = SDL_GetTicksNS() - start;
+                         if (done)
+                             done->fetch_add(1, std::memory_order_relaxed);
+                     });
+
+    DecodedPackMedia res;
+    for (std::size_t i = 0; i < imageCount; ++i)
+        if (images[i])
+            res.images.emplace_back(files.textures[i].first, std::move(images[i]));
+    for (std::size_t i = 0; i < audios.size(); ++i)
+        if (audioLoaded[i])
+            res.audios.push_back({files.audios[i].first, std::move(audios[i]), core::managers::AudioManager::estimateBytes(files.audios[i].second)});
+    if (!durations.empty())
+        res.longestNS = *std::max_element(durations.begin(), durations.end());
+    return res;
+}
+
+} // namespace IO
@@ -0,0 +1,499 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <SDL3/SDL_filesystem.h>
+#include <SDL3/SDL_iostream.h>
+#include <SDL3/SDL_log.h>
+
+#include <App/Statistic/AllGameStatistic.hpp>
+#include <Core/StringUtils.hpp>
+
+#include "MappedFile.hpp"
+
+// Статистика на диске: снимок (stat.bin) и журнал изменений после него (stat.journal).
+// Оба файла - заголовок и записи вида [тип, размер, FNV-1a содержимого, содержимое].
+// Запись - полное состояние одной игры или настроек, поэтому повторное применение безвредно,
+// а недописанный при падении хвост журнала отбрасывается по контрольной сумме.
+namespace IO::statjournal
+{
+
+inline constexpr const std::uint32_t magic = 0x4A545355; // "USTJ"
+inline constexpr const std::uint32_t version = 1;
+
+enum class RecordType : std::uint32_t
+{
+    Settings = 1,
+    Game = 2
+};
+
+struct FileHeader
+{
+    std::uint32_t magic = statjournal::magic;
+    std::uint32_t version = statjournal::version;
+};
+
+struct RecordHeader
+{
+    std::uint32_t type = 0;
+    std::uint32_t size = 0;
+    std::uint64_t checksum = 0;
+};
+
+namespace detail
+{
+
+template <typename T>
+void put(std::string &out, const T &value)
+{
+    out.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+inline void putString(std::string &out, const std::string_view str)
+{
+    put(out, static_cast<std::uint32_t>(str.size()));
+    out.append(str);
+}
+
+// Чтение по порядку с проверкой границ; после первой ошибки ok() == false
+class Reader
+{
+public:
+    explicit Reader(const std::string_view data) : data_(data)
+    {
+    }
+
+    template <typename T>
+    T get()
+    {
+        T res{};
+        if (!ok_ || data_.size() - pos_ < sizeof(T))
+        {
+            ok_ = false;
+            return res;
+        }
+        std::memcpy(&res, data_.data() + pos_, sizeof(T));
+        pos_ += sizeof(T);
+        return res;
+    }
+
+    std::string getString()
+    {
+        const std::uint32_t size = get<std::uint32_t>();
+        if (!ok_ || data_.size() - pos_ < size)
+        {
+            ok_ = false;
+            return {};
+        }
+        std::string res(data_.substr(pos_, size));
+        pos_ += size;
+        return res;
+    }
+
+    bool ok() const
+    {
+        return ok_;
+    }
+
+private:
+    std::string_view data_;
+    std::size_t pos_ = 0;
+    bool ok_ = true;
+};
+
+} // namespace detail
+
+inline std::string encodeRecord(const RecordType type, const std::string_view payload)
+{
+    RecordHeader header;
+    header.type = static_cast<std::uint32_t>(type);
+    header.size = static_cast<std::uint32_t>(payload.size());
+    header.checksum = core::fnv1a(payload);
+    std::string res;
+    res.reserve(sizeof(RecordHeader) + payload.size());
+    detail::put(res, header);
+    res.append(payload);
+    return res;
+}
+
+inline std::string encodeSettings(const std::string_view lastPackage, const float volume)
+{
+    std::string payload;
+    detail::putString(payload, lastPackage);
+    detail::put(payload, volume);
+    return encodeRecord(RecordType::Settings, payload);
+}
+
+inline std::string encodeGame(const statistic::GameStatistic &gs)
+{
+    std::string payload;
+    detail::putString(payload, gs.stringID);
+    detail::putString(payload, gs.name);
+    detail::put(payload, gs.time.minuts);
+    detail::put(payload, gs.time.seconds);
+    detail::put(payload, static_cast<std::uint32_t>(gs.record));
+    detail::put(payload, static_cast<std::uint32_t>(gs.gameCount));
+    return encodeRecord(RecordType::Game, payload);
+}
+
+// Вызывает f(type, payload, record) для каждой целой записи; возвращает их число или -1, если заголовок чужой.
+// Чтение останавливается на первой повреждённой записи, torn - после неё остались байты.
+template <typename F>
+long long forEachRecord(const std::string_view data, F &&f, bool *torn = nullptr)
+{
+    FileHeader header;
+    if (data.size() < sizeof(FileHeader))
+        return -1;
+    std::memcpy(&header, data.data(), sizeof(FileHeader));
+    if (header.magic != magic || header.version != version)
+        return -1;
+
+    long long count = 0;
+    std::size_t pos = sizeof(FileHeader);
+    while (data.size() - pos >= sizeof(RecordHeader))
+    {
+        RecordHeader rec;
+        std::memcpy(&rec, data.data() + pos, sizeof(RecordHeader));
+        if (data.size() - pos - sizeof(RecordHeader) < rec.size)
+            break;
+        const std::string_view payload = data.substr(pos + sizeof(RecordHeader), rec.size);
+        if (core::fnv1a(payload) != rec.checksum)
+            break;
+        f(static_cast<RecordType>(rec.type), payload, data.substr(pos, sizeof(RecordHeader) + rec.size));
+        pos += sizeof(RecordHeader) + rec.size;
+        ++count;
+    }
+    if (torn)
+        *torn = pos != data.size();
+    if (pos != data.size())
+        SDL_Log("StatisticJournal: dropped %zu bytes of a torn tail", data.size() - pos);
+    return count;
+}
+
+inline std::string fileHeader()
+{
+    std::string res;
+    detail::put(res, FileHeader{});
+    return res;
+}
+
+// Целиком во временный файл, затем переименование поверх: на диске всегда старая или новая версия
+inline bool writeFileAtomic(const std::filesystem::path &path, const std::string &data)
+{
+    std::filesystem::path tmp = path;
+    tmp += ".tmp";
+    SDL_IOStream *io = SDL_IOFromFile(tmp.string().c_str(), "wb");
+    if (!io)
+    {
+        SDL_Log("StatisticJournal: %s", SDL_GetError());
+        return false;
+    }
+    const bool written = SDL_WriteIO(io, data.data(), data.size()) == data.size() && SDL_FlushIO(io);
+    if (!SDL_CloseIO(io) || !written)
+    {
+        SDL_Log("StatisticJournal: failed to write %s", tmp.string().c_str());
+        return false;
+    }
+    if (!SDL_RenamePath(tmp.string().c_str(), path.string().c_str()))
+    {
+        SDL_Log("StatisticJournal: %s", SDL_GetError());
+        return false;
+    }
+    return true;
+}
+
+inline bool appendFile(const std::filesystem::path &path, const std::string &data)
+{
+    SDL_IOStream *io = SDL_IOFromFile(path.string().c_str(), "ab");
+    if (!io)
+    {
+        SDL_Log("StatisticJournal: %s", SDL_GetError());
+        return false;
+    }
+    const bool written = SDL_WriteIO(io, data.data(), data.size()) == data.size() && SDL_FlushIO(io);
+    return SDL_CloseIO(io) && written;
+}
+
+} // namespace IO::statjournal
+
+namespace IO
+{
+
+// Сохранение статистики в фоновом потоке. Главный поток только кладёт запись в очередь (put*),
+// поток дописывает накопленное в журнал раз в debounce или сразу для срочных записей (новый рекорд),
+// а когда журнал вырастает до compactAfter записей - атомарно переписывает снимок и обнуляет журнал.
+class StatisticStore
+{
+public:
+    inline static constexpr const std::chrono::milliseconds debounce{1000};
+    inline static constexpr const std::size_t compactAfter = 64;
+
+public:
+    StatisticStore() = default;
+    StatisticStore(const StatisticStore &) = delete;
+    StatisticStore &operator=(const StatisticStore &) = delete;
+    ~StatisticStore()
+    {
+        stop();
+    }
+
+    void setFiles(std::filesystem::path snapshotFile, std::filesystem::path journalFile)
+    {
+        snapshotFile_ = std::move(snapshotFile);
+        journalFile_ = std::move(journalFile);
+    }
+
+    // До start(): снимок и журнал поверх него; false - снимка нет (нужен импорт из XML)
+    bool load(statistic::AllGameStatistic &stat, std::string &currentPackName, float &volume)
+    {
+        stat.clear();
+        latest_.clear();
+        keys_.clear();
+        journalRecords_ = 0;
+        journalReady_ = false;
+
+        auto apply = [&](const statjournal::RecordType type, const std::string_view payload, const std::string_view record)
+        {
+            statjournal::detail::Reader in(payload);
+            if (type == statjournal::RecordType::Settings)
+            {
+                std::string lastPackage = in.getString();
+                const float vol = in.get<float>();
+                if (!in.ok())
+                    return;
+                currentPackName = std::move(lastPackage);
+                volume = vol;
+                remember({}, std::string(record));
+            }
+            else if (type == statjournal::RecordType::Game)
+            {
+                statistic::GameStatistic gs;
+                gs.stringID = in.getString();
+                gs.name = in.getString();
+                gs.time.minuts = in.get<std::uint8_t>();
+                gs.time.seconds = in.get<std::uint8_t>();
+                gs.record = in.get<std::uint32_t>();
+                gs.gameCount = in.get<std::uint32_t>();
+                if (!in.ok() || gs.stringID.empty())
+                    return;
+                remember(gs.stringID, std::string(record));
+                stat.addGame(std::move(gs));
+            }
+        };
+
+        const MappedFile snapshot(snapshotFile_);
+        if (statjournal::forEachRecord(snapshot.view(), apply) < 0 || stat.empty())
+            return false;
+        const MappedFile journal(journalFile_);
+        bool torn = false;
+        const long long records = statjournal::forEachRecord(journal.view(), apply, &torn);
+        // За недописанным хвостом новые записи не прочитались бы - журнал пересоздаётся
+        journalReady_ = records >= 0 && !torn;
+        journalRecords_ = journalReady_ ? static_cast<std::size_t>(records) : 0;
+        return true;
+    }
+
+    // До start(): полное состояние сразу в снимок (импорт из XML)
+    bool reset(const statistic::AllGameStatistic &stat, const std::string &currentPackName, const float volume)
+    {
+        latest_.clear();
+        keys_.clear();
+        remember({}, statjournal::encodeSettings(currentPackName, volume));
+        for (const auto &gs : stat.getAll())
+            remember(gs.stringID, statjournal::encodeGame(gs));
+        return compact();
+    }
+
+    void start()
+    {
+        stop();
+        stop_ = false;
+        stopped_ = false;
+        running_ = true;
+        worker_ = std::thread([this]() { workerLoop(); });
+    }
+
+    // Дописывает очередь и останавливает поток (выход из приложения). Дальше put* пишут сразу, в вызывающем потоке
+    void stop()
+    {
+        {
+            std::lock_guard lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_one();
+        if (!worker_.joinable())
+            return;
+        worker_.join();
+        std::lock_guard lock(mutex_);
+        stopped_ = true;
+    }
+
+    void putGame(const statistic::GameStatistic &gs, const bool urgent = false)
+    {
+        put(gs.stringID, statjournal::encodeGame(gs), urgent);
+    }
+
+    void putSettings(const std::string &currentPackName, const float volume)
+    {
+        put({}, statjournal::encodeSettings(currentPackName, volume), false);
+    }
+
+    // Записывает очередь без ожидания debounce и ждёт, пока запись дойдёт до файла.
+    // Уход в фон на Android: после возврата процесс могут заморозить или убить.
+    void flush()
+    {
+        std::unique_lock lock(mutex_);
+        const std::uint64_t target = queued_;
+        if (written_ >= target || !running_)
+            return;
+        urgent_ = true;
+        wake_.notify_one();
+        flushed_.wait(lock, [this, target]() { return written_ >= target || !running_; });
+    }
+
+private:
+    std::filesystem::path snapshotFile_;
+    std::filesystem::path journalFile_;
+
+    std::thread worker_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    // Под mutex_: ключ (id игры, "" - настройки) -> закодированная запись; повторы схлопываются
+    std::vector<std::pair<std::string, std::string>> pending_;
+    std::chrono::steady_clock::time_point firstPending_;
+    bool urgent_ = false;
+    bool stop_ = true;
+    bool running_ = false;      // поток записи работает
+    bool stopped_ = false;      // поток записи был и остановлен: записывать больше некому
+    std::uint64_t queued_ = 0;  // номер последнего put
+    std::uint64_t written_ = 0; // номер последнего put, дошедшего до файла
+    std::condition_variable flushed_;
+
+    // Только поток записи (до start() - главный): последняя запись каждого ключа для снимка
+    std::vector<std::pair<std::string, std::string>> latest_;
+    std::unordered_map<std::string, std::size_t> keys_;
+    std::size_t journalRecords_ = 0;
+    bool journalReady_ = false; // у журнала есть заголовок, можно дописывать
+
+private:
+    void put(std::string key, std::string record, const bool urgent)
+    {
+        {
+            std::unique_lock lock(mutex_);
+            if (stopped_)
+            {
+                // После stop() запись в очереди потерялась бы: пишется сразу (поток записи уже завершён)
+                lock.unlock();
+                std::vector<std::pair<std::string, std::string>> batch;
+                batch.emplace_back(std::move(key), std::move(record));
+                write(std::move(batch));
+                return;
+            }
+            if (pending_.empty())
+                firstPending_ = std::chrono::steady_clock::now();
+            auto found = std::find_if(pending_.begin(), pending_.end(), [&key](const auto &item) { return item.first == key; });
+            if (found != pending_.end())
+                found->second = std::move(record);
+            else
+                pending_.emplace_back(std::move(key), std::move(record));
+            urgent_ = urgent_ || urgent;
+            ++queued_;
+        }
+        if (urgent)
+            wake_.notify_one();
+    }
+
+    void remember(const std::string &key, std::string record)
+    {
+        if (auto found = keys_.find(key); found != keys_.end())
+            latest_[found->second].second = std::move(record);
+        else
+        {
+            keys_.emplace(key, latest_.size());
+            latest_.emplace_back(key, std::move(record));
+        }
+    }
+
+    void workerLoop()
+    {
+        if (!journalReady_ || journalRecords_ >= compactAfter)
+            compact();
+
+        std::unique_lock lock(mutex_);
+        while (true)
+        {
+            wake_.wait(lock, [this]() { return stop_ || !pending_.empty(); });
+            if (!stop_ && !urgent_)
+                wake_.wait_until(lock, firstPending_ + debounce, [this]() { return stop_ || urgent_; });
+
+            std::vector<std::pair<std::string, std::string>> batch = std::move(pending_);
+            pending_.clear();
+            urgent_ = false;
+            const bool stopping = stop_;
+            const std::uint64_t batchEnd = queued_;
+            lock.unlock();
+
+            if (!batch.empty())
+                write(std::move(batch));
+
+            lock.lock();
+            written_ = batchEnd;
+            flushed_.notify_all();
+            if (stopping && pending_.empty())
+            {
+                running_ = false;
+                flushed_.notify_all();
+                return;
+            }
+        }
+    }
+
+    void write(std::vector<std::pair<std::string, std::string>> batch)
+    {
+        std::string data;
+        for (const auto &item : batch)
+            data += item.second;
+        for (auto &[key, record] : batch)
+            remember(key, std::move(record));
+
+        // Журнала нет или он чужой - записи попадут в снимок
+        if (!journalReady_ || !statjournal::appendFile(journalFile_, data))
+        {
+            compact();
+            return;
+        }
+        journalRecords_ += batch.size();
+        if (journalRecords_ >= compactAfter)
+            compact();
+    }
+
+    // Снимок из последних записей и пустой журнал
+    bool compact()
+    {
+        std::string data = statjournal::fileHeader();
+        for (const auto &item : latest_)
+            data += item.second;
+        if (!statjournal::writeFileAtomic(snapshotFile_, data))
+            return false;
+        // Падение до этой строки не страшно: журнал повторяет записи, уже вошедшие в снимок
+        if (!statjournal::writeFileAtomic(journalFile_, statjournal::fileHeader()))
+            return false;
+        journalRecords_ = 0;
+        journalReady_ = true;
+        return true;
+    }
+};
+
+} // namespace IO
@@ -0,0 +1,609 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_surface.h>
+
+#include <box2d/b2_circle_shape.h>
+#include <box2d/b2_polygon_shape.h>
+
+#include <App/HardStrings.hpp>
+#include <App/Render/TextureAtlas.hpp>
+#include <App/Resources/ObjectPack.hpp>
+#include <Core/StringUtils.hpp>
+
+#include "MappedFile.hpp"
+#include "ObjectPackIO.hpp"
+
+// Двоичный пакет .upack: плоский заголовок, разобранные ObjectDef, готовая геометрия фикстур и мешей,
+// страницы атласа в RGBA32. Собирается упаковщиком (src/Tools/UPacker.cpp), читается без разбора текста.
+// Все числа little-endian, секции - массивы POD-записей по смещениям из заголовка.
+namespace IO::upack
+{
+
+inline constexpr const std::uint32_t magic = 0x4B435055; // "UPCK"
+inline constexpr const std::uint32_t version = 2;
+inline constexpr const std::uint32_t noString = std::numeric_limits<std::uint32_t>::max();
+
+struct Section
+{
+    std::uint64_t offset = 0;
+    std::uint64_t count = 0;
+};
+
+struct Header
+{
+    std::uint32_t magic = upack::magic;
+    std::uint32_t version = upack::version;
+    std::uint64_t configHash = 0; // core::fnv1a(config.xml) - .upack устарел, если не совпадает
+    std::uint64_t mediaHash = 0;  // картинки, запечённые в страницы (upack::mediaHash)
+
+    std::uint32_t levelFrom = 1;
+    std::uint32_t levelTo = 1;
+    float summonTimeStepS = 0.f;
+    std::uint32_t deathCount = 1;
+
+    // Смещения в strings, пути относительно папки пакета
+    std::uint32_t backgroundFile = noString;
+    std::uint32_t winFile = noString;
+    std::uint32_t loseFile = noString;
+    std::uint32_t reserved = 0;
+
+    Section objects;
+    Section polygons;
+    Section circles;
+    Section points;  // SDL_FPoint: вершины форм, точки и UV мешей
+    Section indices; // std::int32_t
+    Section pages;
+    Section regions;
+    Section strings; // char, строки с нулём в конце
+};
+
+struct ObjectRecord
+{
+    std::uint32_t id = 0;
+    std::uint32_t level = 0;
+    std::int32_t points = 0;
+    std::uint8_t formType = 0;
+    std::uint8_t fillerType = 0;
+    std::uint8_t color[4] = {255, 255, 255, 255};
+    std::uint8_t pad[2] = {};
+
+    float formX = 0.f; // радиус / полуоси / размер
+    float formY = 0.f;
+    std::uint32_t formPointFirst = 0; // вершины многоугольника формы
+    std::uint32_t formPointCount = 0;
+
+    std::uint32_t texture = noString;
+    std::uint32_t sound = noString;
+
+    std::uint32_t polygonFirst = 0;
+    std::uint32_t polygonCount = 0;
+    std::uint32_t circleFirst = 0;
+    std::uint32_t circleCount = 0;
+    float friction = 0.f;
+
+    std::uint32_t meshPointFirst = 0; // meshPointCount точек, за ними столько же UV
+    std::uint32_t meshPointCount = 0;
+    std::uint32_t meshIndexFirst = 0;
+    std::uint32_t meshIndexCount = 0;
+};
+
+// b2PolygonShape как есть (без пересчёта выпуклой оболочки и нормалей)
+struct PolygonRecord
+{
+    float centroid[2] = {};
+    float vertices[b2_maxPolygonVertices][2] = {};
+    float normals[b2_maxPolygonVertices][2] = {};
+    std::uint32_t count = 0;
+    float radius = 0.f;
+};
+
+struct CircleRecord
+{
+    float x = 0.f;
+    float y = 0.f;
+    float radius = 0.f;
+};
+
+// Строки пикселей RGBA32 подряд, pitch = width * 4
+struct PageRecord
+{
+    std::uint32_t width = 0;
+    std::uint32_t height = 0;
+    std::uint64_t pixels = 0; // смещение от начала файла
+};
+
+struct RegionRecord
+{
+    std::uint32_t texture = 0; // строка: путь картинки относительно папки пакета
+    std::uint32_t page = 0;
+    std::int32_t x = 0, y = 0, w = 0, h = 0;
+};
+
+static_assert(std::is_trivially_copyable_v<Header> && std::is_trivially_copyable_v<ObjectRecord> && std::is_trivially_copyable_v<PolygonRecord>);
+
+namespace detail
+{
+
+template <typename T>
+bool sectionValid(const std::string_view data, const Section &section)
+{
+    return section.offset <= data.size() && section.count <= (data.size() - section.offset) / sizeof(T);
+}
+
+// Запись секции по индексу; memcpy - данные файла могут быть не выровнены
+template <typename T>
+T at(const std::string_view data, const Section &section, const std::uint64_t ind)
+{
+    T res;
+    std::memcpy(&res, data.data() + section.offset + ind * sizeof(T), sizeof(T));
+    return res;
+}
+
+inline std::string_view getString(const std::string_view data, const Header &header, const std::uint32_t offset)
+{
+    if (offset == noString || offset >= header.strings.count)
+        return {};
+    const std::string_view strings = data.substr(header.strings.offset, header.strings.count);
+    const std::size_t end = strings.find('\0', offset);
+    return strings.substr(offset, end == std::string_view::npos ? std::string_view::npos : end - offset);
+}
+
+// Фикстура из файла годится для Box2D: 3..b2_maxPolygonVertices вершин, нормали единичные,
+// вершины и центр масс не снаружи ни одного ребра (иначе масса выйдет NaN или отрицательной)
+inline bool polygonValid(const PolygonRecord &poly)
+{
+    if (poly.count < 3 || poly.count > b2_maxPolygonVertices || !std::isfinite(poly.radius))
+        return false;
+    constexpr float eps = 1e-3f;
+    for (std::uint32_t k = 0; k < poly.count; ++k)
+    {
+        const float nx = poly.normals[k][0], ny = poly.normals[k][1];
+        if (!std::isfinite(nx) || !std::isfinite(ny) || std::abs(nx * nx + ny * ny - 1.f) > eps)
+            return false;
+        auto outside = [&](const float x, const float y)
+        {
+            return !std::isfinite(x) || !std::isfinite(y) || nx * (x - poly.vertices[k][0]) + ny * (y - poly.vertices[k][1]) > eps;
+        };
+        if (outside(poly.centroid[0], poly.centroid[1]))
+            return false;
+        for (std::uint32_t j = 0; j < poly.count; ++j)
+            if (outside(poly.vertices[j][0], poly.vertices[j][1]))
+                return false;
+    }
+    return true;
+}
+
+} // namespace detail
+
+// Хэш картинок страниц: имена и содержимое файлов в порядке регионов. Файлы только отображаются
+// в память и хэшируются, без декодирования - это намного дешевле сборки атласа заново.
+inline std::uint64_t mediaHash(const std::filesystem::path &folderPath, const std::vector<std::string> &files)
+{
+    std::uint64_t hash = core::fnv1a({});
+    for (const std::string &file : files)
+    {
+        const MappedFile image(folderPath / file);
+        hash = core::fnv1a(image.view(), core::fnv1a(file, hash));
+    }
+    return hash;
+}
+
+// Разбор .upack в pack и media (звуки - на декодирование), страницы атласа - в pack.getOwnAtlas() до upload().
+// Поверхности страниц ссылаются на data без копирования: data должна жить до TextureAtlas::upload().
+// configHash != 0 - false, если пакет собран по другому config.xml или картинки страниц изменились.
+// maxPageSize != 0 - false, если страница больше (renderer её не загрузит, пусть атлас соберётся из картинок).
+inline bool readUPack(resources::ObjectPack &pack, PackMediaFiles &media, const std::string_view data, const std::string &packName, const std::filesystem::path &folderPath, const bool loadMedia, const std::uint64_t configHash = 0, const int maxPageSize = 0)
+{
+    using namespace detail;
+    Header header;
+    if (data.size() < sizeof(Header))
+        return false;
+    std::memcpy(&header, data.data(), sizeof(Header));
+    if (header.magic != magic || header.version != version)
+    {
+        SDL_Log("UPack: %s has unsupported version", packName.c_str());
+        return false;
+    }
+    if (configHash != 0 && header.configHash != configHash)
+    {
+        SDL_Log("UPack: %s is older than config.xml", packName.c_str());
+        return false;
+    }
+    if (!sectionValid<ObjectRecord>(data, header.objects) || !sectionValid<PolygonRecord>(data, header.polygons) ||
+        !sectionValid<CircleRecord>(data, header.circles) || !sectionValid<SDL_FPoint>(data, header.points) ||
+        !sectionValid<std::int32_t>(data, header.indices) || !sectionValid<PageRecord>(data, header.pages) ||
+        !sectionValid<RegionRecord>(data, header.regions) || !sectionValid<char>(data, header.strings))
+    {
+        SDL_Log("UPack: %s is corrupted", packName.c_str());
+        return false;
+    }
+    if (loadMedia)
+    {
+        for (std::uint64_t i = 0; maxPageSize > 0 && i < header.pages.count; ++i)
+        {
+            const PageRecord page = at<PageRecord>(data, header.pages, i);
+            if (page.width > static_cast<std::uint32_t>(maxPageSize) || page.height > static_cast<std::uint32_t>(maxPageSize))
+            {
+                SDL_Log("UPack: %s page %ux%u exceeds renderer limit %d", packName.c_str(), page.width, page.height, maxPageSize);
+                return false;
+            }
+        }
+        std::vector<std::string> images;
+        images.reserve(header.regions.count);
+        for (std::uint64_t i = 0; configHash != 0 && i < header.regions.count; ++i)
+            images.emplace_back(getString(data, header, at<RegionRecord>(data, header.regions, i).texture));
+        if (configHash != 0 && header.mediaHash != mediaHash(folderPath, images))
+        {
+            SDL_Log("UPack: %s is older than its images", packName.c_str());
+            return false;
+        }
+    }
+
+    pack.setPackageName(packName);
+
+    resources::PackageSettings setts;
+    setts.levelRange = {header.levelFrom, header.levelTo};
+    setts.summonTimeStepS = header.summonTimeStepS;
+    setts.deathCount = header.deathCount;
+    pack.setSettings(setts);
+
+    auto sound = [&](const std::uint32_t offset)
+    {
+        const std::string file(getString(data, header, offset));
+        return readSound(SounReadSettings{packName, file, folderPath, loadMedia}, media);
+    };
+    resources::PackageMusic mus;
+    const std::string backgroundFile(getString(data, header, header.backgroundFile));
+    mus.backgroundFile = readStreamedSound(SounReadSettings{packName, backgroundFile, folderPath, loadMedia}, mus.backgroundPath);
+    mus.winFile = sound(header.winFile);
+    mus.loseFile = sound(header.loseFile);
+    pack.setMusic(std::move(mus));
+
+    auto pointsRange = [&](const std::uint32_t first, const std::uint32_t count)
+    {
+        return first <= header.points.count && count <= header.points.count - first;
+    };
+
+    for (std::uint64_t i = 0; i < header.objects.count; ++i)
+    {
+        const ObjectRecord rec = at<ObjectRecord>(data, header.objects, i);
+        if (rec.formType > static_cast<std::uint8_t>(resources::ObjectFormType::Rectangle) ||
+            rec.fillerType > static_cast<std::uint8_t>(resources::ObjectFillerType::Color) ||
+            rec.polygonFirst + static_cast<std::uint64_t>(rec.polygonCount) > header.polygons.count ||
+            rec.circleFirst + static_cast<std::uint64_t>(rec.circleCount) > header.circles.count ||
+            rec.meshIndexFirst + static_cast<std::uint64_t>(rec.meshIndexCount) > header.indices.count ||
+            !pointsRange(rec.formPointFirst, rec.formPointCount) || rec.meshPointCount > header.points.count / 2 ||
+            !pointsRange(rec.meshPointFirst, rec.meshPointCount * 2))
+        {
+            SDL_Log("UPack: %s has broken object %u", packName.c_str(), rec.id);
+            return false;
+        }
+
+        resources::ObjectDef def;
+        def.id = rec.id;
+        def.level = rec.level;
+        def.points = rec.points;
+
+        def.form.type = static_cast<resources::ObjectFormType>(rec.formType);
+        switch (def.form.type)
+        {
+        case resources::ObjectFormType::Circle:
+            def.form.form = rec.formX;
+            break;
+        case resources::ObjectFormType::Polygon:
+        {
+            std::vector<sdl3::Vector2f> vertices;
+            vertices.reserve(rec.formPointCount);
+            for (std::uint32_t j = 0; j < rec.formPointCount; ++j)
+            {
+                const SDL_FPoint p = at<SDL_FPoint>(data, header.points, rec.formPointFirst + j);
+                vertices.push_back({p.x, p.y});
+            }
+            def.form.form = std::move(vertices);
+            break;
+        }
+        default:
+            def.form.form = sdl3::Vector2f{rec.formX, rec.formY};
+            break;
+        }
+
+        def.filler.type = static_cast<resources::ObjectFillerType>(rec.fillerType);
+        if (def.filler.type == resources::ObjectFillerType::Texture)
+        {
+            const std::string file(getString(data, header, rec.texture));
+            const std::string key = mediaKey(packName, file);
+            def.filler.filler = key;
+            // Картинки - на случай, если страница не создастся или не загрузится: их соберут заново или загрузят по одной
+            if (loadMedia && std::none_of(media.textures.begin(), media.textures.end(), [&key](const auto &p) { return p.first == key; }))
+                media.textures.emplace_back(key, folderPath / file);
+        }
+        else
+        {
+            sdl3::Color color;
+            color.r = rec.color[0];
+            color.g = rec.color[1];
+            color.b = rec.color[2];
+            color.a = rec.color[3];
+            def.filler.filler = color;
+        }
+        if (rec.sound != noString)
+            def.soundFile = sound(rec.sound);
+
+        def.body.friction = rec.friction;
+        def.body.polygons.reserve(rec.polygonCount);
+        for (std::uint32_t j = 0; j < rec.polygonCount; ++j)
+        {
+            const PolygonRecord poly = at<PolygonRecord>(data, header.polygons, rec.polygonFirst + j);
+            if (!polygonValid(poly))
+            {
+                SDL_Log("UPack: %s has broken fixture of object %u", packName.c_str(), rec.id);
+                return false;
+            }
+            b2PolygonShape shape;
+            shape.m_count = static_cast<int32>(poly.count);
+            shape.m_radius = poly.radius;
+            shape.m_centroid.Set(poly.centroid[0], poly.centroid[1]);
+            for (int32 k = 0; k < shape.m_count; ++k)
+            {
+                shape.m_vertices[k].Set(poly.vertices[k][0], poly.vertices[k][1]);
+                shape.m_normals[k].Set(poly.normals[k][0], poly.normals[k][1]);
+            }
+            def.body.polygons.push_back(shape);
+        }
+        def.body.circles.reserve(rec.circleCount);
+        for (std::uint32_t j = 0; j < rec.circleCount; ++j)
+        {
+            const CircleRecord circle = at<CircleRecord>(data, header.circles, rec.circleFirst + j);
+            b2CircleShape shape;
+            shape.m_p.Set(circle.x, circle.y);
+            shape.m_radius = circle.radius;
+            def.body.circles.push_back(shape);
+        }
+
+        if (loadMedia && rec.meshIndexCount > 0)
+        {
+            def.mesh.points.resize(rec.meshPointCount);
+            def.mesh.uv.resize(rec.meshPointCount);
+            def.mesh.indices.resize(rec.meshIndexCount);
+            const char *points = data.data() + header.points.offset + rec.meshPointFirst * sizeof(SDL_FPoint);
+            std::memcpy(def.mesh.points.data(), points, rec.meshPointCount * sizeof(SDL_FPoint));
+            std::memcpy(def.mesh.uv.data(), points + rec.meshPointCount * sizeof(SDL_FPoint), rec.meshPointCount * sizeof(SDL_FPoint));
+            std::memcpy(def.mesh.indices.data(), data.data() + header.indices.offset + rec.meshIndexFirst * sizeof(std::int32_t), rec.meshIndexCount * sizeof(std::int32_t));
+            // SpriteBatch прибавляет индексы к началу меша: чужой индекс рисует вершины другого объекта
+            if (std::any_of(def.mesh.indices.begin(), def.mesh.indices.end(), [&rec](const std::int32_t ind) { return ind < 0 || static_cast<std::uint32_t>(ind) >= rec.meshPointCount; }))
+            {
+                SDL_Log("UPack: %s has broken mesh of object %u", packName.c_str(), rec.id);
+                return false;
+            }
+        }
+        pack.addObject(std::move(def));
+    }
+
+    if (!loadMedia)
+        return !pack.empty();
+
+    // Страницы атласа: поверхности поверх data, без декодирования и копий
+    std::vector<render::TextureAtlas::ComposedPage> pages(header.pages.count);
+    for (std::uint64_t i = 0; i < header.pages.count; ++i)
+    {
+        const PageRecord page = at<PageRecord>(data, header.pages, i);
+        const std::uint64_t bytes = static_cast<std::uint64_t>(page.width) * page.height * 4;
+        if (page.width == 0 || page.height == 0 || page.pixels > data.size() || bytes > data.size() - page.pixels)
+        {
+            SDL_Log("UPack: %s has broken page %llu", packName.c_str(), static_cast<unsigned long long>(i));
+            return false;
+        }
+        void *pixels = const_cast<char *>(data.data() + page.pixels);
+        pages[i].surface.reset(SDL_CreateSurfaceFrom(static_cast<int>(page.width), static_cast<int>(page.height), SDL_PIXELFORMAT_RGBA32, pixels, static_cast<int>(page.width * 4)));
+        // Без страницы её картинки соберутся из media.textures, как без .upack
+        if (!pages[i].surface)
+            SDL_Log("UPack: %s", SDL_GetError());
+    }
+    for (std::uint64_t i = 0; i < header.regions.count; ++i)
+    {
+        const RegionRecord region = at<RegionRecord>(data, header.regions, i);
+        if (region.page < pages.size())
+            pages[region.page].rects.emplace_back(mediaKey(packName, std::string(getString(data, header, region.texture))), SDL_Rect{region.x, region.y, region.w, region.h});
+    }
+    for (auto &page : pages)
+        pack.getOwnAtlas().addComposedPage(std::move(page));
+    return !pack.empty();
+}
+
+// Хэш config.xml для проверки актуальности .upack (0 - config.xml нет)
+inline std::uint64_t configHash(const std::filesystem::path &folderPath)
+{
+    const MappedFile config(folderPath / assets::packagConf);
+    return config.empty() ? 0 : core::fnv1a(config.view());
+}
+
+// Определения пакета: .upack, если он есть и собран по текущему config.xml, иначе config.xml.
+// Каждый файл читается (отображается) один раз. data - отображённый .upack, страницы атласа
+// ссылаются на него до TextureAtlas::upload().
+// allowBinary == false - только config.xml (страницы .upack некому загрузить на GPU)
+// maxPageSize - предел текстуры renderer (TextureAtlas::pageSizeFor), 0 - без проверки
+inline bool loadPackDefinition(resources::ObjectPack &pack, PackMediaFiles &media, MappedFile &data, const std::string &packName, const std::filesystem::path &folderPath, const bool loadMedia, const bool allowBinary = true, const int maxPageSize = 0)
+{
+    data.close();
+    MappedFile config(folderPath / assets::packagConf);
+    if (allowBinary && data.open(folderPath / assets::packagBinary))
+    {
+        // Хэш до разбора на месте: load_buffer_inplace портит буфер
+        if (readUPack(pack, media, data.view(), packName, folderPath, loadMedia, config.empty() ? 0 : core::fnv1a(config.view()), maxPageSize))
+            return true;
+        pack = {};
+        media = {};
+        data.close();
+    }
+    return parseObjectPack(pack, media, config, packName, folderPath, loadMedia);
+}
+
+// Сборка .upack из разобранного пакета (упаковщик). pages - страницы после TextureAtlas::compose().
+// folderPath - папка пакета: по config.xml и картинкам считаются хэши актуальности.
+inline std::string writeUPack(const resources::ObjectPack &pack, const std::vector<render::TextureAtlas::ComposedPage> &pages, const std::filesystem::path &folderPath)
+{
+    Header header;
+    header.configHash = upack::configHash(folderPath);
+
+    std::string strings;
+    // Все строки - ключи ресурсов; в файл пишется путь относительно папки пакета
+    auto addString = [&strings, &pack](const std::string_view key) -> std::uint32_t
+    {
+        if (key.empty())
+            return noString;
+        const std::string str = mediaFileName(pack.getName(), std::string(key));
+        const auto offset = static_cast<std::uint32_t>(strings.size());
+        strings.append(str);
+        strings.push_back('\0');
+        return offset;
+    };
+
+    const resources::PackageSettings &setts = pack.getSetings();
+    header.levelFrom = setts.levelRange.x;
+    header.levelTo = setts.levelRange.y;
+    header.summonTimeStepS = setts.summonTimeStepS;
+    header.deathCount = setts.deathCount;
+    header.backgroundFile = addString(pack.getMusic().backgroundFile);
+    header.winFile = addString(pack.getMusic().winFile);
+    header.loseFile = addString(pack.getMusic().loseFile);
+
+    std::vector<ObjectRecord> objects;
+    std::vector<PolygonRecord> polygons;
+    std::vector<CircleRecord> circles;
+    std::vector<SDL_FPoint> points;
+    std::vector<std::int32_t> indices;
+
+    for (const auto &[id, def] : pack.getAll())
+    {
+        ObjectRecord rec;
+        rec.id = def.id;
+        rec.level = def.level;
+        rec.points = def.points;
+        rec.formType = static_cast<std::uint8_t>(def.form.type);
+        rec.fillerType = static_cast<std::uint8_t>(def.filler.type);
+
+        switch (def.form.type)
+        {
+        case resources::ObjectFormType::Circle:
+            rec.formX = def.form.getRadius();
+            break;
+        case resources::ObjectFormType::Polygon:
+            rec.formPointFirst = static_cast<std::uint32_t>(points.size());
+            rec.formPointCount = static_cast<std::uint32_t>(def.form.getPolygon().size());
+            for (const sdl3::Vector2f &v : def.form.getPolygon())
+                points.push_back({v.x, v.y});
+            break;
+        default:
+            rec.formX = def.form.getSize().x;
+            rec.formY = def.form.getSize().y;
+            break;
+        }
+
+        if (def.filler.type == resources::ObjectFillerType::Texture)
+            rec.texture = addString(def.filler.getTextureName());
+        else
+        {
+            const sdl3::Color color = def.filler.getColor();
+            rec.color[0] = static_cast<std::uint8_t>(color.r);
+            rec.color[1] = static_cast<std::uint8_t>(color.g);
+            rec.color[2] = static_cast<std::uint8_t>(color.b);
+            rec.color[3] = static_cast<std::uint8_t>(color.a);
+        }
+        rec.sound = addString(def.soundFile);
+
+        rec.friction = def.body.friction;
+        rec.polygonFirst = static_cast<std::uint32_t>(polygons.size());
+        rec.polygonCount = static_cast<std::uint32_t>(def.body.polygons.size());
+        for (const b2PolygonShape &shape : def.body.polygons)
+        {
+            PolygonRecord poly;
+            poly.count = static_cast<std::uint32_t>(shape.m_count);
+            poly.radius = shape.m_radius;
+            poly.centroid[0] = shape.m_centroid.x;
+            poly.centroid[1] = shape.m_centroid.y;
+            for (int32 k = 0; k < shape.m_count; ++k)
+            {
+                poly.vertices[k][0] = shape.m_vertices[k].x;
+                poly.vertices[k][1] = shape.m_vertices[k].y;
+                poly.normals[k][0] = shape.m_normals[k].x;
+                poly.normals[k][1] = shape.m_normals[k].y;
+            }
+            polygons.push_back(poly);
+        }
+        rec.circleFirst = static_cast<std::uint32_t>(circles.size());
+        rec.circleCount = static_cast<std::uint32_t>(def.body.circles.size());
+        for (const b2CircleShape &shape : def.body.circles)
+            circles.push_back({shape.m_p.x, shape.m_p.y, shape.m_radius});
+
+        rec.meshPointFirst = static_cast<std::uint32_t>(points.size());
+        rec.meshPointCount = static_cast<std::uint32_t>(def.mesh.points.size());
+        points.insert(points.end(), def.mesh.points.begin(), def.mesh.points.end());
+        points.insert(points.end(), def.mesh.uv.begin(), def.mesh.uv.end());
+        rec.meshIndexFirst = static_cast<std::uint32_t>(indices.size());
+        rec.meshIndexCount = static_cast<std::uint32_t>(def.mesh.indices.size());
+        indices.insert(indices.end(), def.mesh.indices.begin(), def.mesh.indices.end());
+
+        objects.push_back(rec);
+    }
+
+    std::vector<PageRecord> pageRecords;
+    std::vector<RegionRecord> regions;
+    std::vector<std::string> images;
+    for (const auto &page : pages)
+    {
+        const auto pageInd = static_cast<std::uint32_t>(pageRecords.size());
+        pageRecords.push_back({static_cast<std::uint32_t>(page.surface->w), static_cast<std::uint32_t>(page.surface->h), 0});
+        for (const auto &[key, rect] : page.rects)
+        {
+            regions.push_back({addString(key), pageInd, rect.x, rect.y, rect.w, rect.h});
+            images.push_back(mediaFileName(pack.getName(), key));
+        }
+    }
+    header.mediaHash = mediaHash(folderPath, images);
+
+    // Секции по порядку, каждая выровнена на 8 байт
+    std::string out(sizeof(Header), '\0');
+    auto append = [&out]<typename T>(const std::vector<T> &items, Section &section)
+    {
+        out.resize((out.size() + 7) & ~std::size_t(7), '\0');
+        section.offset = out.size();
+        section.count = items.size();
+        out.append(reinterpret_cast<const char *>(items.data()), items.size() * sizeof(T));
+    };
+    append(objects, header.objects);
+    append(polygons, header.polygons);
+    append(circles, header.circles);
+    append(points, header.points);
+    append(indices, header.indices);
+    append(pageRecords, header.pages);
+    append(regions, header.regions);
+    append(std::vector<char>(strings.begin(), strings.end()), header.strings);
+
+    for (std::size_t i = 0; i < pages.size(); ++i)
+    {
+        const SDL_Surface *surface = pages[i].surface.get();
+        out.resize((out.size() + 15) & ~std::size_t(15), '\0');
+        pageRecords[i].pixels = out.size();
+        for (int y = 0; y < surface->h; ++y)
+            out.append(static_cast<const char *>(surface->pixels) + static_cast<std::size_t>(y) * surface->pitch, static_cast<std::size_t>(surface->w) * 4);
+    }
+    if (!pageRecords.empty())
+        std::memcpy(out.data() + header.pages.offset, pageRecords.data(), pageRecords.size() * sizeof(PageRecord));
+    std::memcpy(out.data(), &header, sizeof(Header));
+    return out;
+}
+
+} // namespace IO::upack
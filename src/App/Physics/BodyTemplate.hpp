@@ -0,0 +1,32 @@
+#pragma once
+
+#include <vector>
+
+#include <box2d/b2_circle_shape.h>
+#include <box2d/b2_polygon_shape.h>
+
+#include "Config.hpp"
+
+namespace physics
+{
+
+// Готовая геометрия тела (в метрах, в локальных координатах).
+// Считается один раз при загрузке пакета, при создании тела фикстуры только копируются.
+struct BodyTemplate
+{
+    std::vector<b2PolygonShape> polygons;
+    std::vector<b2CircleShape> circles;
+    float friction = Config::defaultFrictionRect;
+
+    bool empty() const
+    {
+        return polygons.empty() && circles.empty();
+    }
+
+    std::size_t fixtureCount() const
+    {
+        return polygons.size() + circles.size();
+    }
+};
+
+} // namespace physics
@@ -10,4 +10,11 @@ inline constexpr const float defaultDensity = 1.f;
 inline constexpr const float defaultFrictionRect = 0.3f;
 inline constexpr const float defaultFrictionEllipse = 0.5f;
 inline constexpr const float defaultFrictionCircle = 0.5f;
+
+// Максимальное отклонение многоугольника от эллипса (в пикселях)
+inline constexpr const float ellipseTolerance = 1.f;
+
+// Фиксированный шаг мира и максимум шагов за кадр (остаток после зависания отбрасывается)
+inline constexpr const float fixedTimeStep = 1.f / 60.f;
+inline constexpr const int maxSubSteps = 5;
 } // namespace Config
\ No newline at end of file
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <box2d/box2d.h>
+
+namespace physics::ConvexDecomposition
+{
+
+using Polygon = std::vector<b2Vec2>;
+
+namespace detail
+{
+
+inline float cross(const b2Vec2 &a, const b2Vec2 &b, const b2Vec2 &c)
+{
+    return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+}
+
+inline float signedArea(const Polygon &poly)
+{
+    float area = 0.f;
+    for (std::size_t i = 0, j = poly.size() - 1; i < poly.size(); j = i++)
+        area += poly[j].x * poly[i].y - poly[i].x * poly[j].y;
+    return area * 0.5f;
+}
+
+// Точка внутри треугольника abc (против часовой) или на его границе
+inline bool inTriangle(const b2Vec2 &p, const b2Vec2 &a, const b2Vec2 &b, const b2Vec2 &c, const float eps)
+{
+    return cross(a, b, p) >= -eps && cross(b, c, p) >= -eps && cross(c, a, p) >= -eps;
+}
+
+// Убирает совпадающие и лежащие на одной прямой вершины, приводит обход к "против часовой"
+inline Polygon cleanup(Polygon poly, const float eps)
+{
+    bool changed = true;
+    while (changed && poly.size() >= 3)
+    {
+        changed = false;
+        for (std::size_t i = 0; i < poly.size() && poly.size() >= 3; ++i)
+        {
+            const b2Vec2 &prev = poly[(i + poly.size() - 1) % poly.size()];
+            const b2Vec2 &cur = poly[i];
+            const b2Vec2 &next = poly[(i + 1) % poly.size()];
+            if (b2DistanceSquared(prev, cur) <= eps * eps || std::fabs(cross(prev, cur, next)) <= eps * eps)
+            {
+                poly.erase(poly.begin() + i);
+                changed = true;
+                break;
+            }
+        }
+    }
+    if (poly.size() >= 3 && signedArea(poly) < 0.f)
+        std::reverse(poly.begin(), poly.end());
+    return poly;
+}
+
+// Ear clipping. Возвращает треугольники индексами в poly, пусто - если полигон самопересекающийся.
+inline std::vector<std::vector<std::size_t>> triangulate(const Polygon &poly, const float eps)
+{
+    std::vector<std::vector<std::size_t>> res;
+    std::vector<std::size_t> rest(poly.size());
+    for (std::size_t i = 0; i < rest.size(); ++i)
+        rest[i] = i;
+
+    while (rest.size() > 3)
+    {
+        bool clipped = false;
+        for (std::size_t i = 0; i < rest.size(); ++i)
+        {
+            const std::size_t ia = rest[(i + rest.size() - 1) % rest.size()];
+            const std::size_t ib = rest[i];
+            const std::size_t ic = rest[(i + 1) % rest.size()];
+            const b2Vec2 &a = poly[ia];
+            const b2Vec2 &b = poly[ib];
+            const b2Vec2 &c = poly[ic];
+
+            if (cross(a, b, c) <= eps * eps)
+                continue; // вогнутая вершина - не ухо
+
+            bool isEar = true;
+            for (const std::size_t ip : rest)
+            {
+                if (ip == ia || ip == ib || ip == ic)
+                    continue;
+                if (inTriangle(poly[ip], a, b, c, eps * eps))
+                {
+                    isEar = false;
+                    break;
+                }
+            }
+            if (!isEar)
+                continue;
+
+            res.push_back({ia, ib, ic});
+            rest.erase(rest.begin() + i);
+            clipped = true;
+            break;
+        }
+        if (!clipped)
+            return {};
+    }
+    res.push_back({rest[0], rest[1], rest[2]});
+    return res;
+}
+
+inline bool isConvex(const Polygon &poly, const std::vector<std::size_t> &piece, const float eps)
+{
+    for (std::size_t i = 0; i < piece.size(); ++i)
+    {
+        const b2Vec2 &a = poly[piece[(i + piece.size() - 1) % piece.size()]];
+        const b2Vec2 &b = poly[piece[i]];
+        const b2Vec2 &c = poly[piece[(i + 1) % piece.size()]];
+        if (cross(a, b, c) < -eps * eps)
+            return false;
+    }
+    return true;
+}
+
+// Склейка двух кусков по общему ребру (a -> b в first, b -> a в second)
+inline bool tryMerge(const Polygon &poly, const std::vector<std::size_t> &first, const std::vector<std::size_t> &second, const std::size_t maxVertices, const float eps, std::vector<std::size_t> &out)
+{
+    if (first.size() + second.size() - 2 > maxVertices)
+        return false;
+
+    for (std::size_t i = 0; i < first.size(); ++i)
+    {
+        const std::size_t a = first[i];
+        const std::size_t b = first[(i + 1) % first.size()];
+        for (std::size_t j = 0; j < second.size(); ++j)
+        {
+            if (second[j] != b || second[(j + 1) % second.size()] != a)
+                continue;
+
+            // first: b ... a (без ребра a->b), second: a ... b без концов
+            out.clear();
+            for (std::size_t k = 0; k < first.size(); ++k)
+                out.push_back(first[(i + 1 + k) % first.size()]);
+            for (std::size_t k = 2; k < second.size(); ++k)
+                out.push_back(second[(j + k) % second.size()]);
+            return isConvex(poly, out, eps);
+        }
+    }
+    return false;
+}
+
+} // namespace detail
+
+// Разбивает простой (возможно невыпуклый) полигон на выпуклые куски не более чем по maxVertices вершин:
+// ear clipping + жадный Hertel-Mehlhorn. Не минимум: кусков не больше чем вчетверо против оптимального разбиения.
+// Пустой результат - полигон вырожденный или самопересекающийся.
+inline std::vector<Polygon> decompose(const Polygon &input, const std::size_t maxVertices = b2_maxPolygonVertices, const float eps = b2_linearSlop)
+{
+    const Polygon poly = detail::cleanup(input, eps);
+    if (poly.size() < 3)
+        return {};
+
+    std::vector<std::vector<std::size_t>> pieces = detail::triangulate(poly, eps);
+    if (pieces.empty())
+        return {};
+
+    // Hertel-Mehlhorn: убираем диагонали, пока куски остаются выпуклыми
+    std::vector<std::size_t> merged;
+    for (bool changed = true; changed;)
+    {
+        changed = false;
+        for (std::size_t i = 0; i < pieces.size() && !changed; ++i)
+            for (std::size_t j = i + 1; j < pieces.size() && !changed; ++j)
+                if (detail::tryMerge(poly, pieces[i], pieces[j], maxVertices, eps, merged))
+                {
+                    pieces[i] = merged;
+                    pieces.erase(pieces.begin() + j);
+                    changed = true;
+                }
+    }
+
+    std::vector<Polygon> res;
+    res.reserve(pieces.size());
+    for (const auto &piece : pieces)
+    {
+        Polygon &out = res.emplace_back();
+        out.reserve(piece.size());
+        for (const std::size_t ind : piece)
+            out.push_back(poly[ind]);
+    }
+    return res;
+}
+
+} // namespace physics::ConvexDecomposition
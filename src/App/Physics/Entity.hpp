@@ -5,6 +5,7 @@
 #include <box2d/box2d.h>
 
 #include "Config.hpp"
+#include <App/Render/Mesh.hpp>
 #include <Core/Types.hpp>
 
 namespace physics
@@ -17,12 +18,17 @@ public:
         : m_body(body), m_shape(std::move(shape))
     {
         if (m_body)
+        {
             m_body->GetUserData().pointer = reinterpret_cast<uintptr_t>(this);
+            savePrevious();
+        }
         ID_ = maxID_++;
     }
     Entity(const Entity &) = delete;
     Entity(Entity &&other) noexcept
-        : m_body(other.m_body), m_shape(std::move(other.m_shape)), ID_{other.ID_}
+        : m_body(other.m_body), m_shape(std::move(other.m_shape)), ID_{other.ID_},
+          prevPos_(other.prevPos_), prevAngle_(other.prevAngle_), alpha_(other.alpha_), dirty_(other.dirty_),
+          sprite_(other.sprite_)
     {
         other.m_body = nullptr;
         if (m_body)
@@ -53,6 +59,11 @@ public:
             m_body = other.m_body;
             m_shape = std::move(other.m_shape);
             ID_ = other.ID_;
+            prevPos_ = other.prevPos_;
+            prevAngle_ = other.prevAngle_;
+            alpha_ = other.alpha_;
+            dirty_ = other.dirty_;
+            sprite_ = other.sprite_;
             other.m_body = nullptr;
 
             if (m_body)
@@ -71,7 +82,9 @@ public:
     void setPosition(sdl3::Vector2f pos_px)
     {
         m_body->SetTransform({pos_px.x * Config::MPP, pos_px.y * Config::MPP}, m_body->GetAngle());
+        savePrevious();
         update();
+        dirty_ = true;
     }
     sdl3::Vector2f getPosition() const
     {
@@ -82,7 +95,43 @@ public:
     void setRotation(float degrees)
     {
         m_body->SetTransform(m_body->GetPosition(), degrees * SDL_PI_F / 180.f);
+        savePrevious();
         update();
+        dirty_ = true;
+    }
+
+    // Интерполяция отрисовки между шагами физики
+
+    // Запоминает положение тела перед шагом мира
+    void savePrevious()
+    {
+        prevPos_ = m_body->GetPosition();
+        prevAngle_ = m_body->GetAngle();
+    }
+    // 0 - положение до последнего шага, 1 - текущее положение тела
+    void setRenderAlpha(const float alpha)
+    {
+        alpha_ = alpha;
+    }
+
+    // Переносит положение тела в фигуру. Спящие тела, которые не двигались
+    // с прошлой синхронизации, пропускаются. Вызывается после шага мира.
+    void syncShape()
+    {
+        if (!m_body)
+            return;
+        const bool awake = m_body->IsAwake();
+        if (!awake && !dirty_)
+            return;
+        if (awake && alpha_ < 1.f)
+            updateInterpolated();
+        else
+        {
+            update();
+            savePrevious();
+        }
+        // Проснувшееся тело нужно синхронизировать ещё раз, когда оно уснёт
+        dirty_ = awake;
     }
 
     const b2Body *getBody() const
@@ -94,6 +143,16 @@ public:
         return *m_shape;
     }
 
+    // Меш для render::SpriteBatch. Меш принадлежит ObjectDef или владельцу сущности.
+    void setSprite(const render::Sprite &sprite)
+    {
+        sprite_ = sprite;
+    }
+    const render::Sprite &getSprite() const
+    {
+        return sprite_;
+    }
+
     const unsigned short getID() const
     {
         return ID_;
@@ -121,6 +180,13 @@ private:
 
     IDType ID_ = 0;
 
+    b2Vec2 prevPos_ = b2Vec2_zero;
+    float prevAngle_ = 0.f;
+    float alpha_ = 1.f;
+    bool dirty_ = true;
+
+    render::Sprite sprite_;
+
     inline static unsigned short maxID_ = 1;
 
 private:
@@ -130,9 +196,17 @@ private:
         m_shape->setPosition({pos.x * Config::PPM, pos.y * Config::PPM});
         m_shape->setRotation(m_body->GetAngle() * 180.f / SDL_PI_F);
     }
+    void updateInterpolated() const
+    {
+        const b2Vec2 &pos = m_body->GetPosition();
+        const float x = prevPos_.x + (pos.x - prevPos_.x) * alpha_;
+        const float y = prevPos_.y + (pos.y - prevPos_.y) * alpha_;
+        const float angle = prevAngle_ + (m_body->GetAngle() - prevAngle_) * alpha_;
+        m_shape->setPosition({x * Config::PPM, y * Config::PPM});
+        m_shape->setRotation(angle * 180.f / SDL_PI_F);
+    }
     void draw(sdl3::RenderTarget &target) const override
     {
-        update();
         target.draw(*m_shape.get());
     }
 };
@@ -4,12 +4,17 @@
 #include <SDLWrapper/DrawTransformObjects/PolygonShape.hpp>
 #include <SDLWrapper/Names.hpp>
 
+#include "BodyTemplate.hpp"
 #include "Config.hpp"
+#include "ConvexDecomposition.hpp"
 #include "Entity.hpp"
 #include "box2d/b2_circle_shape.h"
 
+#include <algorithm>
 #include <array>
 #include <box2d/b2_polygon_shape.h>
+#include <cmath>
+#include <memory>
 
 namespace physics::EntityFactory
 {
@@ -22,26 +27,38 @@ inline b2Body *createBaseBody(b2World &world, const sdl3::Shape &shape, b2BodyDe
     return world.CreateBody(&bd);
 }
 
-// 1. Перегрузка для ПРЯМОУГОЛЬНИКА
-inline Entity createFromShape(b2World &world, const sdl3::RectangleShape &rect, b2BodyDef bd, b2FixtureDef fd)
+// --- Геометрия тел (BodyTemplate) ---
+
+// 1. ПРЯМОУГОЛЬНИК
+inline BodyTemplate makeRectangleTemplate(const sdl3::Vector2f size)
 {
-    auto shapeCopy = std::make_unique<sdl3::RectangleShape>(rect);
-    sdl3::Vector2f boxSize = shapeCopy->getSize() * 0.5f * Config::MPP;
-    b2Body *body = createBaseBody(world, *shapeCopy, std::move(bd));
+    BodyTemplate res;
+    res.friction = Config::defaultFrictionRect;
+
+    const sdl3::Vector2f boxSize = size * 0.5f * Config::MPP;
     b2PolygonShape box;
     box.SetAsBox(boxSize.x, boxSize.y);
-    fd.shape = &box;
-    body->CreateFixture(&fd);
-    return Entity(body, std::move(shapeCopy));
+    res.polygons.push_back(box);
+    return res;
 }
 
-// 2. Перегрузка для ЭЛЛИПСА
-inline Entity createFromShape(b2World &world, const sdl3::EllipseShape &ellipse, b2BodyDef bd, b2FixtureDef fd, const unsigned segments = 24)
+// 2. ЭЛЛИПС
+
+// Построитель тела эллипса. Sectors - старый вариант, оставлен для сравнения в --headless
+enum class EllipseBuilder : unsigned char
 {
-    auto shapeCopy = std::make_unique<sdl3::EllipseShape>(ellipse);
-    const sdl3::Vector2f bodyRadii = shapeCopy->getRadii() * Config::MPP;
+    Adaptive,
+    Sectors
+};
 
-    b2Body *body = createBaseBody(world, *shapeCopy, std::move(bd));
+// Старый вариант: segments треугольных секторов из центра
+inline BodyTemplate makeEllipseSectorsTemplate(const sdl3::Vector2f radii, const unsigned segments = 24)
+{
+    BodyTemplate res;
+    res.friction = Config::defaultFrictionEllipse;
+    res.polygons.reserve(segments);
+
+    const sdl3::Vector2f bodyRadii = radii * Config::MPP;
 
     for (int i = 0; i < segments; ++i)
     {
@@ -51,171 +68,286 @@ inline Entity createFromShape(b2World &world, const sdl3::EllipseShape &ellipse,
         b2Vec2 v[3] = {{0, 0}, {bodyRadii.x * cosf(a1), bodyRadii.y * sinf(a1)}, {bodyRadii.x * cosf(a2), bodyRadii.y * sinf(a2)}};
         b2PolygonShape sector;
         sector.Set(v, 3);
-
-        b2FixtureDef fdPr = fd;
-        fdPr.shape = &sector;
-
-        body->CreateFixture(&fdPr);
+        res.polygons.push_back(sector);
     }
-
-    return Entity(body, std::move(shapeCopy));
+    return res;
 }
 
-// 3. Перегрузка для ОКРУЖНОСТИ
-inline Entity createFromShape(b2World &world, const sdl3::CircleShape &circle, b2BodyDef bd, b2FixtureDef fd)
+// Вписанный многоугольник, отклоняющийся от эллипса не больше чем на tolerance пикселей,
+// разбитый на выпуклые секторы до b2_maxPolygonVertices вершин.
+// Почти круглый эллипс становится одной окружностью.
+inline BodyTemplate makeEllipseTemplate(const sdl3::Vector2f radii, const float tolerance = Config::ellipseTolerance)
 {
-    auto shapeCopy = std::make_unique<sdl3::CircleShape>(circle);
+    BodyTemplate res;
+    res.friction = Config::defaultFrictionEllipse;
 
-    b2Body *body = createBaseBody(world, *shapeCopy, std::move(bd));
-    b2CircleShape shape;
-    shape.m_radius = circle.getRadius() * Config::MPP;
-    fd.shape = &shape;
-    body->CreateFixture(&fd);
-    return Entity(body, std::move(shapeCopy));
-}
+    const float maxRadius = std::max(radii.x, radii.y);
+    if (std::fabs(radii.x - radii.y) <= tolerance)
+    {
+        b2CircleShape shape;
+        shape.m_radius = (radii.x + radii.y) * 0.5f * Config::MPP;
+        res.circles.push_back(shape);
+        return res;
+    }
 
-// 4. Перегрузка для ПРОИЗВОЛЬНОГО ПОЛИГОНА (может быть невыпуклый)
-// ПРИМЕЧАНИЕ: После изменений этот метод корректно работает только для выпуклых полигонов.
-inline Entity createFromShape(b2World &world, const sdl3::PolygonShape &polyShape, b2BodyDef bd, b2FixtureDef fd)
-{
-    auto shapeCopy = std::make_unique<sdl3::PolygonShape>(polyShape);
+    // Отклонение хорды от дуги радиуса R: R * (1 - cos(pi / N))
+    const float ratio = std::clamp(1.f - tolerance / maxRadius, -1.f, 1.f);
+    const int edges = std::clamp(static_cast<int>(std::ceil(b2_pi / std::acos(ratio))), b2_maxPolygonVertices, 64);
 
-    const auto &points = shapeCopy->getPoints();
-    if (points.size() < 3)
+    const sdl3::Vector2f bodyRadii = radii * Config::MPP;
+    auto vertex = [&](const int i)
     {
-        // Недостаточно точек для создания хотя бы одного треугольника
-        b2Body *body = createBaseBody(world, *shapeCopy, std::move(bd));
-        return Entity(body, std::move(shapeCopy));
-    }
+        const float a = static_cast<float>(i) / edges * 2.0f * b2_pi;
+        return b2Vec2{bodyRadii.x * cosf(a), bodyRadii.y * sinf(a)};
+    };
 
-    // Локальные -> Box2D (метры)
-    std::vector<b2Vec2> verts;
-    verts.reserve(points.size());
-    for (const auto &p : points)
+    // Один кусок - весь многоугольник
+    if (edges <= b2_maxPolygonVertices)
     {
-        verts.emplace_back(p.x * Config::MPP, p.y * Config::MPP);
+        b2Vec2 v[b2_maxPolygonVertices];
+        for (int i = 0; i < edges; ++i)
+            v[i] = vertex(i);
+        b2PolygonShape poly;
+        poly.Set(v, edges);
+        res.polygons.push_back(poly);
+        return res;
     }
 
-    // --- НАЧАЛО ИЗМЕНЕНИЙ ---
-    // Упрощенная веерная триангуляция.
-    // Вместо сложного алгоритма "ear clipping" создаем треугольники,
-    // используя общую вершину в локальной точке (0,0).
-    std::vector<std::array<b2Vec2, 3>> triangles;
-    const b2Vec2 centerPoint(0.0f, 0.0f);
-
-    // Создаем треугольники, соединяя каждую пару соседних вершин с центром.
-    for (size_t i = 0; i < verts.size(); ++i)
+    // Сектор из центра: центр + (рёбра сектора + 1) вершин на контуре.
+    // Не меньше трёх секторов: сектор шире 180° (9 рёбер на 2 куска) невыпуклый в центре,
+    // Set() взял бы его оболочку без центра, и куски перекрылись бы
+    const int maxEdgesPerPiece = b2_maxPolygonVertices - 2;
+    const int pieces = std::max((edges + maxEdgesPerPiece - 1) / maxEdgesPerPiece, 3);
+
+    res.polygons.reserve(pieces);
+    float piecesArea = 0.f;
+    float polygonArea = 0.f;
+    int first = 0;
+    for (int p = 0; p < pieces; ++p)
     {
-        // Берем текущую вершину и следующую (с замыканием на первую)
-        const b2Vec2 &p1 = verts[i];
-        const b2Vec2 &p2 = verts[(i + 1) % verts.size()];
+        // Рёбра делятся между секторами поровну
+        const int last = (edges * (p + 1)) / pieces;
+        b2Vec2 v[b2_maxPolygonVertices];
+        int count = 0;
+        v[count++] = {0.f, 0.f};
+        for (int i = first; i <= last; ++i)
+            v[count++] = vertex(i);
 
-        // Треугольник состоит из центра и двух соседних вершин полигона.
-        std::array<b2Vec2, 3> tri = {centerPoint, p1, p2};
-        triangles.push_back(tri);
+        b2PolygonShape sector;
+        sector.Set(v, count);
+        b2MassData mass;
+        sector.ComputeMass(&mass, 1.f);
+        piecesArea += mass.mass;
+        for (int i = 1; i + 1 < count; ++i)
+            polygonArea += 0.5f * b2Cross(v[i], v[i + 1]);
+        res.polygons.push_back(sector);
+        first = last;
     }
-    // --- КОНЕЦ ИЗМЕНЕНИЙ ---
+    // Куски не перекрываются: их площадь равна площади вписанного многоугольника
+    if (std::fabs(piecesArea - polygonArea) > 1e-3f * polygonArea)
+        SDL_Log("Ellipse %.1fx%.1f: fixtures area %f != polygon area %f", radii.x, radii.y, piecesArea, polygonArea);
+    return res;
+}
 
-    b2Body *body = createBaseBody(world, *shapeCopy, std::move(bd));
+inline BodyTemplate makeEllipseTemplate(const sdl3::Vector2f radii, const EllipseBuilder builder)
+{
+    return builder == EllipseBuilder::Sectors ? makeEllipseSectorsTemplate(radii) : makeEllipseTemplate(radii);
+}
+
+// 3. ОКРУЖНОСТЬ
+inline BodyTemplate makeCircleTemplate(const float radius)
+{
+    BodyTemplate res;
+    res.friction = Config::defaultFrictionCircle;
 
-    int i = 0;
-    const float minArea2 = 1e-4f;
+    b2CircleShape shape;
+    shape.m_radius = radius * Config::MPP;
+    res.circles.push_back(shape);
+    return res;
+}
+
+// Веерная триангуляция вокруг локальной точки (0,0).
+// Корректна только для полигонов, звёздных относительно (0,0); используется как запасной вариант.
+inline void fanTriangulate(const std::vector<b2Vec2> &verts, BodyTemplate &res)
+{
+    const b2Vec2 centerPoint(0.0f, 0.0f);
 
-    for (const auto &tri : triangles)
+    // Создаем треугольники, соединяя каждую пару соседних вершин с центром.
+    for (size_t i = 0; i < verts.size(); ++i)
     {
-        ++i;
+        // Треугольник состоит из центра и двух соседних вершин полигона.
+        std::array<b2Vec2, 3> tri = {centerPoint, verts[i], verts[(i + 1) % verts.size()]};
 
         b2PolygonShape poly;
         poly.Set(tri.data(), 3);
 
-        // 2) проверяем, что Box2D реально оставил >= 3 вершин
+        // проверяем, что Box2D реально оставил >= 3 вершин
         if (poly.m_count < 3)
         {
             SDL_Log("Degenerate triangle after Box2D cleanup, skip #%d (count=%d)\n",
-                    i, poly.m_count);
+                    static_cast<int>(i + 1), poly.m_count);
             continue;
         }
+        res.polygons.push_back(poly);
+    }
+}
+
+// 4. ПРОИЗВОЛЬНЫЙ ПОЛИГОН (может быть невыпуклый)
+// Разбивается на выпуклые куски до b2_maxPolygonVertices вершин (ConvexDecomposition::decompose, не минимальное число).
+inline BodyTemplate makePolygonTemplate(const std::vector<sdl3::Vector2f> &points)
+{
+    BodyTemplate res;
+    // можешь завести свой Config::defaultFrictionPolygon,
+    // пока возьмём, например, прямоугольник:
+    res.friction = Config::defaultFrictionRect;
+
+    // Недостаточно точек для создания хотя бы одного треугольника
+    if (points.size() < 3)
+        return res;
+
+    // Локальные -> Box2D (метры)
+    std::vector<b2Vec2> verts;
+    verts.reserve(points.size());
+    for (const auto &p : points)
+    {
+        verts.emplace_back(p.x * Config::MPP, p.y * Config::MPP);
+    }
+
+    const std::vector<ConvexDecomposition::Polygon> pieces = ConvexDecomposition::decompose(verts);
+    if (pieces.empty())
+    {
+        SDL_Log("Polygon is self-intersecting or degenerate, fallback to fan triangulation\n");
+        fanTriangulate(verts, res);
+        return res;
+    }
 
-        b2FixtureDef fdPr = fd;
-        fdPr.shape = &poly;
-        body->CreateFixture(&fdPr);
+    res.polygons.reserve(pieces.size());
+    for (const auto &piece : pieces)
+    {
+        // Box2D заменяет вырожденный полигон квадратом, такие куски пропускаем
+        if (std::fabs(ConvexDecomposition::detail::signedArea(piece)) <= b2_linearSlop * b2_linearSlop)
+            continue;
+        b2PolygonShape poly;
+        poly.Set(piece.data(), static_cast<int32>(piece.size()));
+        res.polygons.push_back(poly);
     }
 
-    return Entity(body, std::move(shapeCopy));
+    return res;
 }
 
-// --- Методы для создания по параметрам ---
+// --- Создание тела ---
 
-inline Entity createRectangle(b2World &world, sdl3::Vector2f pos, sdl3::Vector2f size, sdl3::Color color, const sdl3::Texture *texture = nullptr, b2BodyType type = b2_dynamicBody)
+// Копирует готовые фикстуры в новое тело
+inline Entity createFromTemplate(b2World &world, std::unique_ptr<sdl3::Shape> shape, const BodyTemplate &tmpl, b2BodyDef bd, b2FixtureDef fd)
 {
-    sdl3::RectangleShape rect(size);
-    rect.setOrigin(size / 2.f);
-    rect.setPosition(pos);
-    rect.setFillColor(color);
-    if (texture)
-        rect.setTexture(*texture);
+    b2Body *body = createBaseBody(world, *shape, std::move(bd));
+    for (const b2PolygonShape &poly : tmpl.polygons)
+    {
+        fd.shape = &poly;
+        body->CreateFixture(&fd);
+    }
+    for (const b2CircleShape &circle : tmpl.circles)
+    {
+        fd.shape = &circle;
+        body->CreateFixture(&fd);
+    }
+    return Entity(body, std::move(shape));
+}
 
+inline Entity createFromTemplate(b2World &world, std::unique_ptr<sdl3::Shape> shape, const BodyTemplate &tmpl, b2BodyType type = b2_dynamicBody)
+{
     b2BodyDef bd;
     bd.type = type;
     b2FixtureDef fd;
     fd.density = (type == b2_staticBody) ? 0.0f : Config::defaultDensity;
-    fd.friction = Config::defaultFrictionRect;
+    fd.friction = tmpl.friction;
 
-    return createFromShape(world, rect, bd, fd);
+    return createFromTemplate(world, std::move(shape), tmpl, bd, fd);
 }
 
-inline Entity createEllipse(b2World &world, sdl3::Vector2f pos, sdl3::Vector2f radii, sdl3::Color color, const sdl3::Texture *texture = nullptr, b2BodyType type = b2_dynamicBody)
+inline Entity createFromShape(b2World &world, const sdl3::RectangleShape &rect, b2BodyDef bd, b2FixtureDef fd)
 {
-    sdl3::EllipseShape ell(radii);
-    ell.setPosition(pos);
-    ell.setFillColor(color);
-    if (texture)
-        ell.setTexture(*texture);
+    return createFromTemplate(world, std::make_unique<sdl3::RectangleShape>(rect), makeRectangleTemplate(rect.getSize()), std::move(bd), std::move(fd));
+}
 
-    b2BodyDef bd;
-    bd.type = type;
-    b2FixtureDef fd;
-    fd.density = (type == b2_staticBody) ? 0.0f : Config::defaultDensity;
-    fd.friction = Config::defaultFrictionEllipse;
+inline Entity createFromShape(b2World &world, const sdl3::EllipseShape &ellipse, b2BodyDef bd, b2FixtureDef fd, const float tolerance = Config::ellipseTolerance)
+{
+    return createFromTemplate(world, std::make_unique<sdl3::EllipseShape>(ellipse), makeEllipseTemplate(ellipse.getRadii(), tolerance), std::move(bd), std::move(fd));
+}
 
-    return createFromShape(world, ell, bd, fd);
+inline Entity createFromShape(b2World &world, const sdl3::CircleShape &circle, b2BodyDef bd, b2FixtureDef fd)
+{
+    return createFromTemplate(world, std::make_unique<sdl3::CircleShape>(circle), makeCircleTemplate(circle.getRadius()), std::move(bd), std::move(fd));
 }
 
-inline Entity createCircle(b2World &world, sdl3::Vector2f pos, const float radius, sdl3::Color color, const sdl3::Texture *texture = nullptr, b2BodyType type = b2_dynamicBody)
+inline Entity createFromShape(b2World &world, const sdl3::PolygonShape &polyShape, b2BodyDef bd, b2FixtureDef fd)
 {
-    sdl3::CircleShape circ(radius);
-    circ.setPosition(pos);
-    circ.setFillColor(color);
+    return createFromTemplate(world, std::make_unique<sdl3::PolygonShape>(polyShape), makePolygonTemplate(polyShape.getPoints()), std::move(bd), std::move(fd));
+}
+
+// --- Отрисовываемые фигуры ---
+
+inline std::unique_ptr<sdl3::Shape> makeRectangleShape(sdl3::Vector2f pos, sdl3::Vector2f size, sdl3::Color color, const sdl3::Texture *texture = nullptr)
+{
+    auto rect = std::make_unique<sdl3::RectangleShape>(size);
+    rect->setOrigin(size / 2.f);
+    rect->setPosition(pos);
+    rect->setFillColor(color);
     if (texture)
-        circ.setTexture(*texture);
+        rect->setTexture(*texture);
+    return rect;
+}
 
-    b2BodyDef bd;
-    bd.type = type;
-    b2FixtureDef fd;
-    fd.density = (type == b2_staticBody) ? 0.0f : Config::defaultDensity;
-    fd.friction = Config::defaultFrictionCircle;
+inline std::unique_ptr<sdl3::Shape> makeEllipseShape(sdl3::Vector2f pos, sdl3::Vector2f radii, sdl3::Color color, const sdl3::Texture *texture = nullptr)
+{
+    auto ell = std::make_unique<sdl3::EllipseShape>(radii);
+    ell->setPosition(pos);
+    ell->setFillColor(color);
+    if (texture)
+        ell->setTexture(*texture);
+    return ell;
+}
 
-    return createFromShape(world, circ, bd, fd);
+inline std::unique_ptr<sdl3::Shape> makeCircleShape(sdl3::Vector2f pos, const float radius, sdl3::Color color, const sdl3::Texture *texture = nullptr)
+{
+    auto circ = std::make_unique<sdl3::CircleShape>(radius);
+    circ->setPosition(pos);
+    circ->setFillColor(color);
+    if (texture)
+        circ->setTexture(*texture);
+    return circ;
 }
 
-inline Entity createPolygon(b2World &world, sdl3::Vector2f pos, const std::vector<sdl3::Vector2f> &points, sdl3::Color color, const sdl3::Texture *texture = nullptr, b2BodyType type = b2_dynamicBody)
+inline std::unique_ptr<sdl3::Shape> makePolygonShape(sdl3::Vector2f pos, const std::vector<sdl3::Vector2f> &points, sdl3::Color color, const sdl3::Texture *texture = nullptr)
 {
-    sdl3::PolygonShape poly(points);
-    poly.setPosition(pos);
-    poly.setFillColor(color);
+    auto poly = std::make_unique<sdl3::PolygonShape>(points);
+    poly->setPosition(pos);
+    poly->setFillColor(color);
     if (texture)
-        poly.setTexture(*texture);
+        poly->setTexture(*texture);
+    return poly;
+}
 
-    b2BodyDef bd;
-    bd.type = type;
+// --- Методы для создания по параметрам ---
 
-    b2FixtureDef fd;
-    fd.density = (type == b2_staticBody) ? 0.0f : Config::defaultDensity;
-    // можешь завести свой Config::defaultFrictionPolygon,
-    // пока возьмём, например, прямоугольник:
-    fd.friction = Config::defaultFrictionRect;
+inline Entity createRectangle(b2World &world, sdl3::Vector2f pos, sdl3::Vector2f size, sdl3::Color color, const sdl3::Texture *texture = nullptr, b2BodyType type = b2_dynamicBody)
+{
+    return createFromTemplate(world, makeRectangleShape(pos, size, color, texture), makeRectangleTemplate(size), type);
+}
 
-    return createFromShape(world, poly, bd, fd);
+inline Entity createEllipse(b2World &world, sdl3::Vector2f pos, sdl3::Vector2f radii, sdl3::Color color, const sdl3::Texture *texture = nullptr, b2BodyType type = b2_dynamicBody)
+{
+    return createFromTemplate(world, makeEllipseShape(pos, radii, color, texture), makeEllipseTemplate(radii), type);
+}
+
+inline Entity createCircle(b2World &world, sdl3::Vector2f pos, const float radius, sdl3::Color color, const sdl3::Texture *texture = nullptr, b2BodyType type = b2_dynamicBody)
+{
+    return createFromTemplate(world, makeCircleShape(pos, radius, color, texture), makeCircleTemplate(radius), type);
+}
+
+inline Entity createPolygon(b2World &world, sdl3::Vector2f pos, const std::vector<sdl3::Vector2f> &points, sdl3::Color color, const sdl3::Texture *texture = nullptr, b2BodyType type = b2_dynamicBody)
+{
+    return createFromTemplate(world, makePolygonShape(pos, points, color, texture), makePolygonTemplate(points), type);
 }
 
-} // namespace physics::EntityFactory
\ No newline at end of file
+} // namespace physics::EntityFactory
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <utility>
+
+#include <Core/Managers/ResourceHandle.hpp>
+
+#include "TextureAtlas.hpp"
+
+namespace render
+{
+
+using AtlasHandle = core::managers::ResourceHandle<struct AtlasTag>;
+
+// Атласы пакетов на GPU по имени пакета. Загруженный пакет держит ссылку на свой атлас;
+// отпущенный атлас остаётся, пока хватает бюджета, - повторный вход в пакет не собирает и не грузит страницы заново.
+class AtlasCache
+{
+public:
+    // Ссылка пакета; не nullptr - атлас уже на GPU (попадание)
+    const TextureAtlas *acquire(const std::string_view packName)
+    {
+        const AtlasHandle h = registry_.handle(packName);
+        return registry_.acquire(h) ? registry_.get(h) : nullptr;
+    }
+    void release(const std::string_view packName)
+    {
+        registry_.release(registry_.find(packName));
+    }
+
+    // Атлас после upload(). Ссылку пакет берёт заранее (acquire), чтобы бюджет не выгрузил атлас сразу
+    const TextureAtlas *add(const std::string_view packName, TextureAtlas atlas)
+    {
+        const AtlasHandle h = registry_.handle(packName);
+        TextureAtlas &slot = registry_.slot(h);
+        slot = std::move(atlas);
+        registry_.setBytes(h, slot.bytes());
+        return registry_.get(h);
+    }
+
+    bool has(const std::string_view packName) const
+    {
+        return registry_.get(registry_.find(packName)) != nullptr;
+    }
+
+    void setBudget(const std::size_t bytes)
+    {
+        registry_.setBudget(bytes);
+    }
+    const core::managers::CacheStats &stats() const
+    {
+        return registry_.stats();
+    }
+
+    // Страницы - текстуры renderer: освобождать до его уничтожения
+    void clear()
+    {
+        registry_.clear();
+    }
+
+private:
+    core::managers::ResourceRegistry<TextureAtlas, AtlasHandle> registry_;
+};
+
+} // namespace render
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include <Core/Managers/ResourceHandle.hpp>
+
+#include "TextureAtlas.hpp"
+
+namespace render
+{
+
+// Декодированные картинки (в памяти, не на GPU) по ключу TextureManager.
+// Заполняется прогревом и загрузкой пакетов, читается загрузчиком пакета из фонового потока.
+// Сверх бюджета выгружаются давно не использованные; тот, кто уже взял SharedSurface, её не потеряет.
+class ImageCache
+{
+public:
+    void add(const std::string &key, SharedSurface surface)
+    {
+        if (!surface)
+            return;
+        std::lock_guard lock(mutex_);
+        Entry &entry = images_[key];
+        stats_.bytes -= entry.bytes;
+        entry.bytes = static_cast<std::size_t>(surface->h) * static_cast<std::size_t>(surface->pitch);
+        entry.surface = std::move(surface);
+        entry.lastUse = ++clock_;
+        stats_.bytes += entry.bytes;
+        trim();
+    }
+
+    SharedSurface find(const std::string &key)
+    {
+        std::lock_guard lock(mutex_);
+        auto it = images_.find(key);
+        if (it == images_.end())
+        {
+            ++stats_.misses;
+            return nullptr;
+        }
+        ++stats_.hits;
+        it->second.lastUse = ++clock_;
+        return it->second.surface;
+    }
+
+    void setBudget(const std::size_t bytes)
+    {
+        std::lock_guard lock(mutex_);
+        stats_.budget = bytes;
+        trim();
+    }
+
+    core::managers::CacheStats stats() const
+    {
+        std::lock_guard lock(mutex_);
+        return stats_;
+    }
+
+    std::size_t size() const
+    {
+        std::lock_guard lock(mutex_);
+        return images_.size();
+    }
+
+    void clear()
+    {
+        std::lock_guard lock(mutex_);
+        images_.clear();
+        stats_.bytes = 0;
+    }
+
+private:
+    struct Entry
+    {
+        SharedSurface surface;
+        std::size_t bytes = 0;
+        std::uint64_t lastUse = 0;
+    };
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Entry> images_;
+    std::uint64_t clock_ = 0;
+    core::managers::CacheStats stats_{0, 0, 0, 0, std::numeric_limits<std::size_t>::max()};
+
+private:
+    // Под mutex_
+    void trim()
+    {
+        while (stats_.bytes > stats_.budget && !images_.empty())
+        {
+            auto oldest = images_.begin();
+            for (auto it = images_.begin(); it != images_.end(); ++it)
+                if (it->second.lastUse < oldest->second.lastUse)
+                    oldest = it;
+            stats_.bytes -= oldest->second.bytes;
+            images_.erase(oldest);
+            ++stats_.evictions;
+        }
+    }
+};
+
+} // namespace render
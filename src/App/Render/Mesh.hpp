@@ -0,0 +1,38 @@
+#pragma once
+
+#include <vector>
+
+#include <SDL3/SDL_rect.h>
+#include <SDL3/SDL_render.h>
+#include <SDLWrapper/Math/Colors.hpp>
+#include <SDLWrapper/Texture.hpp>
+
+namespace render
+{
+
+// Треугольники фигуры в локальных координатах (в пикселях, относительно origin фигуры).
+// UV растянуты на габариты фигуры. Считается один раз при загрузке пакета.
+struct Mesh
+{
+    std::vector<SDL_FPoint> points;
+    std::vector<SDL_FPoint> uv;
+    std::vector<int> indices;
+
+    bool empty() const
+    {
+        return indices.empty();
+    }
+};
+
+// Что и чем рисовать для сущности в SpriteBatch.
+// Если задана страница атласа, texture не используется, а UV меша сжимаются в uvRect.
+struct Sprite
+{
+    const Mesh *mesh = nullptr;
+    const sdl3::Texture *texture = nullptr;
+    sdl3::Color color = sdl3::Colors::White;
+    SDL_Texture *page = nullptr;
+    SDL_FRect uvRect = {0.f, 0.f, 1.f, 1.f};
+};
+
+} // namespace render
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <SDL3/SDL_stdinc.h>
+#include <SDLWrapper/Names.hpp>
+
+#include <App/Physics/ConvexDecomposition.hpp>
+
+#include "Mesh.hpp"
+
+namespace render::MeshFactory
+{
+
+// Максимальное отклонение контура круга/эллипса от настоящего (в пикселях)
+inline constexpr const float curveTolerance = 0.5f;
+
+namespace detail
+{
+
+// UV по габаритам точек
+inline void fillUV(Mesh &mesh)
+{
+    if (mesh.points.empty())
+        return;
+    SDL_FPoint min = mesh.points.front();
+    SDL_FPoint max = min;
+    for (const SDL_FPoint &p : mesh.points)
+    {
+        min = {std::min(min.x, p.x), std::min(min.y, p.y)};
+        max = {std::max(max.x, p.x), std::max(max.y, p.y)};
+    }
+    const float w = max.x - min.x > 0.f ? max.x - min.x : 1.f;
+    const float h = max.y - min.y > 0.f ? max.y - min.y : 1.f;
+
+    mesh.uv.resize(mesh.points.size());
+    for (std::size_t i = 0; i < mesh.points.size(); ++i)
+        mesh.uv[i] = {(mesh.points[i].x - min.x) / w, (mesh.points[i].y - min.y) / h};
+}
+
+// Веер треугольников из первой вершины выпуклого контура
+inline void addFan(Mesh &mesh, const std::vector<SDL_FPoint> &contour)
+{
+    const int base = static_cast<int>(mesh.points.size());
+    mesh.points.insert(mesh.points.end(), contour.begin(), contour.end());
+    for (int i = 1; i + 1 < static_cast<int>(contour.size()); ++i)
+        mesh.indices.insert(mesh.indices.end(), {base, base + i, base + i + 1});
+}
+
+} // namespace detail
+
+inline Mesh makeRectangleMesh(const sdl3::Vector2f size)
+{
+    Mesh res;
+    const sdl3::Vector2f half = size / 2.f;
+    detail::addFan(res, {{-half.x, -half.y}, {half.x, -half.y}, {half.x, half.y}, {-half.x, half.y}});
+    detail::fillUV(res);
+    return res;
+}
+
+// Вписанный многоугольник с отклонением не больше tolerance, веер из центра
+inline Mesh makeEllipseMesh(const sdl3::Vector2f radii, const float tolerance = curveTolerance)
+{
+    Mesh res;
+    const float maxRadius = std::max(radii.x, radii.y);
+    if (maxRadius <= 0.f)
+        return res;
+
+    const float cosHalf = std::clamp(1.f - tolerance / maxRadius, -1.f, 1.f);
+    const int segments = std::clamp(static_cast<int>(std::ceil(SDL_PI_F / std::acos(cosHalf))), 12, 96);
+
+    res.points.reserve(segments + 1);
+    res.points.push_back({0.f, 0.f});
+    for (int i = 0; i < segments; ++i)
+    {
+        const float a = static_cast<float>(i) / segments * 2.f * SDL_PI_F;
+        res.points.push_back({radii.x * std::cos(a), radii.y * std::sin(a)});
+    }
+    res.indices.reserve(segments * 3);
+    for (int i = 1; i <= segments; ++i)
+        res.indices.insert(res.indices.end(), {0, i, i % segments + 1});
+    detail::fillUV(res);
+    return res;
+}
+
+inline Mesh makeCircleMesh(const float radius, const float tolerance = curveTolerance)
+{
+    return makeEllipseMesh({radius, radius}, tolerance);
+}
+
+// Невыпуклый полигон режется на выпуклые куски, каждый - веером
+inline Mesh makePolygonMesh(const std::vector<sdl3::Vector2f> &points)
+{
+    Mesh res;
+    if (points.size() < 3)
+        return res;
+
+    physics::ConvexDecomposition::Polygon input;
+    input.reserve(points.size());
+    for (const sdl3::Vector2f &p : points)
+        input.push_back({p.x, p.y});
+
+    const auto pieces = physics::ConvexDecomposition::decompose(input, points.size(), 0.01f);
+    if (pieces.empty())
+    {
+        // Самопересекающийся контур: рисуем как есть
+        std::vector<SDL_FPoint> contour;
+        for (const sdl3::Vector2f &p : points)
+            contour.push_back({p.x, p.y});
+        detail::addFan(res, contour);
+    }
+    for (const auto &piece : pieces)
+    {
+        std::vector<SDL_FPoint> contour;
+        contour.reserve(piece.size());
+        for (const b2Vec2 &p : piece)
+            contour.push_back({p.x, p.y});
+        detail::addFan(res, contour);
+    }
+    detail::fillUV(res);
+    return res;
+}
+
+} // namespace render::MeshFactory
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_render.h>
+#include <SDL3/SDL_stdinc.h>
+#include <SDLWrapper/Names.hpp>
+
+#include <App/Physics/Entity.hpp>
+
+#include "Mesh.hpp"
+
+namespace render
+{
+
+inline SDL_Texture *nativeTexture(const sdl3::Texture *texture)
+{
+    return texture ? std::to_address(texture->getNativeSDLTexture()) : nullptr;
+}
+
+// Собирает фигуры с одной текстурой в общий буфер вершин
+// и рисует каждую текстуру одним SDL_RenderGeometry.
+// Порядок отрисовки сохраняется только внутри одной текстуры.
+class SpriteBatch
+{
+public:
+    void begin()
+    {
+        for (Batch &batch : batches_)
+        {
+            batch.vertices.clear();
+            batch.indices.clear();
+        }
+        drawCalls_ = 0;
+    }
+
+    // false - у сущности нет меша, её нужно рисовать как обычно
+    bool add(const physics::Entity &entity)
+    {
+        const Sprite &sprite = entity.getSprite();
+        if (!sprite.mesh || sprite.mesh->empty())
+            return false;
+        const sdl3::Shape &shape = entity.getShape();
+        add(sprite, shape.getPosition(), shape.getRotation());
+        return true;
+    }
+
+    void add(const Sprite &sprite, const sdl3::Vector2f pos, const float degrees)
+    {
+        const Mesh &mesh = *sprite.mesh;
+        Batch &batch = findBatch(sprite.page ? sprite.page : nativeTexture(sprite.texture));
+        const SDL_FRect &uvRect = sprite.uvRect;
+
+        const float angle = degrees * SDL_PI_F / 180.f;
+        const float c = std::cos(angle);
+        const float s = std::sin(angle);
+        const SDL_FColor color = {sprite.color.r / 255.f, sprite.color.g / 255.f, sprite.color.b / 255.f, sprite.color.a / 255.f};
+
+        const int base = static_cast<int>(batch.vertices.size());
+        for (std::size_t i = 0; i < mesh.points.size(); ++i)
+        {
+            const SDL_FPoint &p = mesh.points[i];
+            const SDL_FPoint &uv = mesh.uv[i];
+            batch.vertices.push_back({{pos.x + p.x * c - p.y * s, pos.y + p.x * s + p.y * c},
+                                      color,
+                                      {uvRect.x + uv.x * uvRect.w, uvRect.y + uv.y * uvRect.h}});
+        }
+        for (const int ind : mesh.indices)
+            batch.indices.push_back(base + ind);
+    }
+
+    void flush(SDL_Renderer *renderer)
+    {
+        for (const Batch &batch : batches_)
+        {
+            if (batch.indices.empty())
+                continue;
+            if (!SDL_RenderGeometry(renderer, batch.texture,
+                                    batch.vertices.data(), static_cast<int>(batch.vertices.size()),
+                                    batch.indices.data(), static_cast<int>(batch.indices.size())))
+                SDL_Log("SpriteBatch: %s", SDL_GetError());
+            ++drawCalls_;
+        }
+    }
+
+    // Вызовов SDL_RenderGeometry в последнем flush
+    std::size_t getDrawCalls() const
+    {
+        return drawCalls_;
+    }
+
+private:
+    struct Batch
+    {
+        SDL_Texture *texture = nullptr;
+        std::vector<SDL_Vertex> vertices;
+        std::vector<int> indices;
+    };
+
+    // Буферы живут между кадрами, чтобы не выделять память заново.
+    // Текстур в пакете немного - поиск линейный.
+    std::vector<Batch> batches_;
+    std::size_t drawCalls_ = 0;
+
+private:
+    Batch &findBatch(SDL_Texture *texture)
+    {
+        for (Batch &batch : batches_)
+            if (batch.texture == texture)
+                return batch;
+        Batch &batch = batches_.emplace_back();
+        batch.texture = texture;
+        return batch;
+    }
+};
+
+} // namespace render
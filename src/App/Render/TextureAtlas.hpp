@@ -0,0 +1,302 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_rect.h>
+#include <SDL3/SDL_render.h>
+#include <SDL3/SDL_surface.h>
+#include <SDL3_image/SDL_image.h>
+
+#include <App/IO/MappedFile.hpp>
+
+namespace render
+{
+
+// Место картинки в атласе: страница и UV-прямоугольник в долях страницы
+struct AtlasRegion
+{
+    SDL_Texture *page = nullptr;
+    SDL_FRect uv = {0.f, 0.f, 1.f, 1.f};
+};
+
+// Декодированная картинка в памяти; атлас и кэш картинок могут держать её одновременно
+using SharedSurface = std::shared_ptr<SDL_Surface>;
+
+// Декодирует файл (любой поток) прямо из отображения в память, без промежуточной копии.
+// Режим смешивания сразу NONE - атлас копирует альфу как есть.
+inline SharedSurface loadSurface(const std::filesystem::path &file)
+{
+    const IO::MappedFile data(file);
+    if (data.empty())
+    {
+        SDL_Log("TextureAtlas: failed to open %s", file.string().c_str());
+        return nullptr;
+    }
+    SDL_Surface *surface = IMG_Load_IO(SDL_IOFromConstMem(data.view().data(), data.size()), true);
+    if (!surface)
+    {
+        SDL_Log("TextureAtlas: %s", SDL_GetError());
+        return nullptr;
+    }
+    SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_NONE);
+    return SharedSurface(surface, SDL_DestroySurface);
+}
+
+// Картинки пакета, разложенные по одной или нескольким страницам (shelf packing).
+// Вместо десятка мелких текстур на GPU загружается несколько больших.
+class TextureAtlas
+{
+public:
+    inline static constexpr const int maxPageSize = 2048;
+    inline static constexpr const int padding = 2;
+
+    struct SurfaceDeleter
+    {
+        void operator()(SDL_Surface *surface) const
+        {
+            SDL_DestroySurface(surface);
+        }
+    };
+    using SurfacePtr = std::unique_ptr<SDL_Surface, SurfaceDeleter>;
+
+    // Страница, собранная в памяти и ещё не загруженная на GPU
+    struct ComposedPage
+    {
+        SurfacePtr surface;
+        std::vector<std::pair<std::string, SDL_Rect>> rects;
+    };
+
+public:
+    // Декодирует картинку. На GPU она попадёт только в build() / upload(). Можно звать не из главного потока.
+    bool add(const std::string &key, const std::filesystem::path &file)
+    {
+        if (contains(key))
+            return true;
+        return add(key, loadSurface(file));
+    }
+
+    // Уже декодированная картинка (loadSurface)
+    bool add(const std::string &key, SharedSurface surface)
+    {
+        if (!surface)
+            return false;
+        if (!contains(key))
+            pending_.push_back({key, std::move(surface)});
+        return true;
+    }
+
+    // Картинка уже в атласе: на GPU, ждёт раскладки или на собранной странице (в том числе из .upack)
+    bool contains(const std::string &key) const
+    {
+        return regions_.contains(key) || std::any_of(pending_.begin(), pending_.end(), [&key](const Pending &p) { return p.key == key; }) ||
+               std::any_of(composed_.begin(), composed_.end(),
+                           [&key](const ComposedPage &page)
+                           {
+                               return std::any_of(page.rects.begin(), page.rects.end(), [&key](const auto &rect) { return rect.first == key; });
+                           });
+    }
+
+    // Раскладывает добавленные картинки по страницам и создаёт текстуры страниц
+    bool build(SDL_Renderer *renderer)
+    {
+        const bool composed = compose(pageSizeFor(renderer));
+        return upload(renderer) && composed;
+    }
+
+    // Наибольшая страница, которую примет renderer
+    static int pageSizeFor(SDL_Renderer *renderer)
+    {
+        return std::min<int>(maxPageSize, static_cast<int>(SDL_GetNumberProperty(SDL_GetRendererProperties(renderer), SDL_PROP_RENDERER_MAX_TEXTURE_SIZE_NUMBER, maxPageSize)));
+    }
+
+    // Раскладка и копирование картинок в поверхности страниц. Без renderer - можно звать не из главного потока.
+    bool compose(const int pageSize)
+    {
+        if (pending_.empty())
+            return true;
+
+        // Высокие картинки первыми - полки получаются плотнее
+        std::sort(pending_.begin(), pending_.end(),
+                  [](const Pending &a, const Pending &b)
+                  {
+                      return a.surface->h > b.surface->h;
+                  });
+
+        bool ok = true;
+        for (const PageLayout &page : layout(pageSize))
+            ok = composePage(page) && ok;
+        pending_.clear();
+        return ok;
+    }
+
+    // Страницы после compose() до upload() (упаковщик .upack)
+    const std::vector<ComposedPage> &getComposedPages() const
+    {
+        return composed_;
+    }
+
+    // Готовая страница (например, из .upack) - на GPU попадёт в upload()
+    void addComposedPage(ComposedPage page)
+    {
+        if (page.surface)
+            composed_.push_back(std::move(page));
+    }
+
+    // Создаёт текстуры собранных страниц (поток renderer)
+    bool upload(SDL_Renderer *renderer)
+    {
+        bool ok = true;
+        for (ComposedPage &page : composed_)
+        {
+            TexturePtr texture(SDL_CreateTextureFromSurface(renderer, page.surface.get()));
+            if (!texture)
+            {
+                SDL_Log("TextureAtlas: %s", SDL_GetError());
+                ok = false;
+                continue;
+            }
+            const float w = static_cast<float>(page.surface->w);
+            const float h = static_cast<float>(page.surface->h);
+            for (const auto &[key, rect] : page.rects)
+                regions_[key] = {texture.get(), {rect.x / w, rect.y / h, rect.w / w, rect.h / h}};
+            bytes_ += static_cast<std::size_t>(page.surface->w) * static_cast<std::size_t>(page.surface->h) * 4;
+            pages_.push_back(std::move(texture));
+        }
+        composed_.clear();
+        return ok;
+    }
+
+    const AtlasRegion *find(const std::string &key) const
+    {
+        auto it = regions_.find(key);
+        return it == regions_.end() ? nullptr : &it->second;
+    }
+
+    std::size_t pageCount() const
+    {
+        return pages_.size();
+    }
+
+    // Объём страниц на GPU (RGBA), для бюджета AtlasCache
+    std::size_t bytes() const
+    {
+        return bytes_;
+    }
+
+    void clear()
+    {
+        pending_.clear();
+        composed_.clear();
+        regions_.clear();
+        pages_.clear();
+        bytes_ = 0;
+    }
+
+private:
+    struct TextureDeleter
+    {
+        void operator()(SDL_Texture *texture) const
+        {
+            SDL_DestroyTexture(texture);
+        }
+    };
+    using TexturePtr = std::unique_ptr<SDL_Texture, TextureDeleter>;
+
+    struct Pending
+    {
+        std::string key;
+        SharedSurface surface;
+    };
+    struct Placement
+    {
+        std::size_t ind = 0; // индекс в pending_
+        SDL_Rect rect = {};
+    };
+    struct PageLayout
+    {
+        int width = 0;
+        int height = 0;
+        std::vector<Placement> placements;
+    };
+
+    std::vector<Pending> pending_;
+    std::vector<ComposedPage> composed_;
+    std::unordered_map<std::string, AtlasRegion> regions_;
+    std::vector<TexturePtr> pages_;
+    std::size_t bytes_ = 0;
+
+private:
+    std::vector<PageLayout> layout(const int pageSize) const
+    {
+        std::vector<PageLayout> res;
+        PageLayout current;
+        int x = 0, y = 0, rowHeight = 0;
+
+        for (std::size_t i = 0; i < pending_.size(); ++i)
+        {
+            const SDL_Surface *surface = pending_[i].surface.get();
+            const int w = surface->w + padding;
+            const int h = surface->h + padding;
+
+            // Не влезает в страницу - своя страница
+            if (w > pageSize || h > pageSize)
+            {
+                res.push_back({surface->w, surface->h, {{i, {0, 0, surface->w, surface->h}}}});
+                continue;
+            }
+            if (x + w > pageSize)
+            {
+                y += rowHeight;
+                x = rowHeight = 0;
+            }
+            if (y + h > pageSize)
+            {
+                res.push_back(std::move(current));
+                current = {};
+                x = y = rowHeight = 0;
+            }
+            current.placements.push_back({i, {x, y, surface->w, surface->h}});
+            current.width = std::max(current.width, x + w);
+            current.height = std::max(current.height, y + h);
+            x += w;
+            rowHeight = std::max(rowHeight, h);
+        }
+        if (!current.placements.empty())
+            res.push_back(std::move(current));
+        return res;
+    }
+
+    bool composePage(const PageLayout &layout)
+    {
+        SurfacePtr page(SDL_CreateSurface(layout.width, layout.height, SDL_PIXELFORMAT_RGBA32));
+        if (!page)
+        {
+            SDL_Log("TextureAtlas: %s", SDL_GetError());
+            return false;
+        }
+        SDL_FillSurfaceRect(page.get(), nullptr, 0);
+
+        ComposedPage composed;
+        for (const Placement &place : layout.placements)
+        {
+            SDL_Surface *src = pending_[place.ind].surface.get();
+            SDL_Rect dst = place.rect;
+            if (!SDL_BlitSurface(src, nullptr, page.get(), &dst))
+                SDL_Log("TextureAtlas: %s", SDL_GetError());
+            composed.rects.emplace_back(pending_[place.ind].key, place.rect);
+        }
+        composed.surface = std::move(page);
+        composed_.push_back(std::move(composed));
+        return true;
+    }
+};
+
+} // namespace render
@@ -41,6 +41,16 @@ public:
         return packages_.loadFolder(activePack_);
     }
 
+    // Фоновая загрузка, готовность - PackageContainer::pollLoad()
+    bool beginLoadPack(const std::string &packName)
+    {
+        activePack_ = packName;
+        if (activePack_.empty())
+            return false;
+        packages_.beginLoadFolder(activePack_);
+        return true;
+    }
+
     void unloadPack()
     {
         if (activePack_.empty())
@@ -98,18 +108,19 @@ public:
             SDL_Log("ObjectFactory: Couldn't find object by ID\n");
             return std::nullopt;
         }
-        const sdl3::Texture *tex = packages_.textures().get(def->filler.getTextureName());
+        const render::Sprite sprite = makeSprite(*def);
+        // Геометрия тела готовится в IO::readObjectPack, здесь только копируется
 
         switch (def->form.type)
         {
         case ObjectFormType::Circle:
-            return createCircle(world, *def, tex, pos, type);
+            return createCircle(world, *def, sprite, pos, type);
         case ObjectFormType::Ellipse:
-            return createEllipse(world, *def, tex, pos, type);
+            return createEllipse(world, *def, sprite, pos, type);
         case ObjectFormType::Polygon:
-            return createPolygon(world, *def, tex, pos, type);
+            return createPolygon(world, *def, sprite, pos, type);
         case ObjectFormType::Rectangle:
-            return createRectangle(world, *def, tex, pos, type);
+            return createRectangle(world, *def, sprite, pos, type);
         default:
             SDL_Log("ObjectFactory: Unsuportable ObjectFormType.\n");
             return std::nullopt;
@@ -122,7 +133,8 @@ public:
         return create(world, def, pos, type);
     }
 
-    void loadSounds(std::unordered_map<IDType, sdl3::audio::Sound>& sounds)
+    // Звуки объектов по id объекта (индекс массива)
+    void loadSounds(std::vector<std::optional<sdl3::audio::Sound>>& sounds)
     {
         sounds.clear();
         core::managers::AudioManager& manager =  packages_.audios();
@@ -132,49 +144,67 @@ public:
             return;
         for(const auto& [id, def] : pack->getAll())
         {
-            // def.soundFile
-            sdl3::audio::Sound sound;
-            const sdl3::audio::Audio* audio = manager.get(def.soundFile);
+            const sdl3::audio::Audio* audio = manager.get(def.sound);
             if(!audio)
                 continue;
-            sound.setAudio(*audio);
-            sounds[id] = std::move(sound);
+            if (sounds.size() <= id)
+                sounds.resize(id + 1);
+            sounds[id].emplace().setAudio(*audio);
         }
     }
 
 private:
-    static objects::GameObject wrapEntity(physics::Entity &&entity, const ObjectDef &def)
+    // Текстура из атласа пакета, если она туда попала, иначе из TextureManager (по номеру, без строк)
+    render::Sprite makeSprite(const ObjectDef &def) const
     {
+        render::Sprite sprite;
+        sprite.mesh = &def.mesh;
+        sprite.color = def.filler.getColor();
+        if (def.filler.type != ObjectFillerType::Texture)
+            return sprite;
+
+        if (def.atlasPage)
+        {
+            sprite.page = def.atlasPage;
+            sprite.uvRect = def.atlasUV;
+        }
+        else
+            sprite.texture = packages_.textures().get(def.texture);
+        return sprite;
+    }
+
+    static objects::GameObject wrapEntity(physics::Entity &&entity, const ObjectDef &def, const render::Sprite &sprite)
+    {
+        entity.setSprite(sprite);
         return objects::GameObject(std::move(entity), def.level, def.points);
     }
 
-    static objects::GameObject createCircle(b2World &world, const ObjectDef &def, const sdl3::Texture *tex, const sdl3::Vector2f pos, const b2BodyType type)
+    static objects::GameObject createCircle(b2World &world, const ObjectDef &def, const render::Sprite &sprite, const sdl3::Vector2f pos, const b2BodyType type)
     {
         const float radius = def.form.getRadius();
         const sdl3::Color color = def.filler.getColor();
-        return wrapEntity(physics::EntityFactory::createCircle(world, pos, radius, color, tex, type), def);
+        return wrapEntity(physics::EntityFactory::createFromTemplate(world, physics::EntityFactory::makeCircleShape(pos, radius, color, sprite.texture), def.body, type), def, sprite);
     }
 
-    static objects::GameObject createEllipse(b2World &world, const ObjectDef &def, const sdl3::Texture *tex, const sdl3::Vector2f pos, const b2BodyType type)
+    static objects::GameObject createEllipse(b2World &world, const ObjectDef &def, const render::Sprite &sprite, const sdl3::Vector2f pos, const b2BodyType type)
     {
         const sdl3::Vector2f radii = def.form.getRadii();
         const sdl3::Color color = def.filler.getColor();
-        return wrapEntity(physics::EntityFactory::createEllipse(world, pos, radii, color, tex, type), def);
+        return wrapEntity(physics::EntityFactory::createFromTemplate(world, physics::EntityFactory::makeEllipseShape(pos, radii, color, sprite.texture), def.body, type), def, sprite);
     }
 
-    static objects::GameObject createRectangle(b2World &world, const ObjectDef &def, const sdl3::Texture *tex, const sdl3::Vector2f pos, const b2BodyType type)
+    static objects::GameObject createRectangle(b2World &world, const ObjectDef &def, const render::Sprite &sprite, const sdl3::Vector2f pos, const b2BodyType type)
     {
         const sdl3::Vector2f size = def.form.getSize();
         const sdl3::Color color = def.filler.getColor();
-        return wrapEntity(physics::EntityFactory::createRectangle(world, pos, size, color, tex, type), def);
+        return wrapEntity(physics::EntityFactory::createFromTemplate(world, physics::EntityFactory::makeRectangleShape(pos, size, color, sprite.texture), def.body, type), def, sprite);
     }
 
-    static objects::GameObject createPolygon(b2World &world, const ObjectDef &def, const sdl3::Texture *tex, const sdl3::Vector2f pos, const b2BodyType type)
+    static objects::GameObject createPolygon(b2World &world, const ObjectDef &def, const render::Sprite &sprite, const sdl3::Vector2f pos, const b2BodyType type)
     {
-
-        const std::vector<sdl3::Vector2f> points = def.form.getPolygon();
+        const std::vector<sdl3::Vector2f> &points = def.form.getPolygon();
         const sdl3::Color color = def.filler.getColor();
-        return wrapEntity(physics::EntityFactory::createPolygon(world, pos, points, color, tex, type), def);
+        return wrapEntity(physics::EntityFactory::createFromTemplate(world, physics::EntityFactory::makePolygonShape(pos, points, color, sprite.texture), def.body, type), def, sprite);
     }
 
 private:
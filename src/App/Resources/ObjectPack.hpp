@@ -9,6 +9,9 @@
 
 #include <pugixml/pugixml.hpp>
 
+#include <App/Physics/EntityFactory.hpp>
+#include <App/Render/AtlasCache.hpp>
+#include <App/Render/TextureAtlas.hpp>
 #include <Core/Managers/TextureManager.hpp>
 #include "Core/Managers/AudioManager.hpp"
 #include "Core/Types.hpp"
@@ -21,18 +24,89 @@ namespace resources
 class ObjectPack
 {
 public:
+    // Отпускает ресурсы пакета; выгрузят их менеджеры, когда не хватит бюджета
     void unload(core::managers::TextureManager &textures, core::managers::AudioManager& audios)
     {
-        for (const auto &key : textureKeys_)
-            textures.unload(key);
-        for (const auto &key : audioKeys_)
-            audios.unload(key);
-        textureKeys_.clear();
+        for (const auto &key : heldTextures_)
+            textures.release(key);
+        for (const auto &key : heldAudios_)
+            audios.release(key);
+        heldTextures_.clear();
+        heldAudios_.clear();
+        if (atlases_)
+            atlases_->release(packName_);
+        atlases_ = nullptr;
+        sharedAtlas_ = nullptr;
+        atlas_.clear();
         objects_.clear();
         packName_.clear();
         folderAbs_.clear();
     }
 
+    // После загрузки медиа и upload() атласа: номера текстур и звуков и место в атласе - прямо в ObjectDef
+    void resolveHandles(core::managers::TextureManager &textures, core::managers::AudioManager &audios)
+    {
+        for (auto &[id, def] : objects_)
+        {
+            if (def.filler.type == ObjectFillerType::Texture)
+            {
+                const std::string &key = def.filler.getTextureName();
+                def.texture = textures.handle(key);
+                if (const render::AtlasRegion *region = getAtlas().find(key))
+                {
+                    def.atlasPage = region->page;
+                    def.atlasUV = region->uv;
+                }
+            }
+            if (!def.soundFile.empty())
+                def.sound = audios.handle(def.soundFile);
+        }
+        auto audio = [&audios](const std::string &key) { return key.empty() ? core::managers::AudioHandle{} : audios.handle(key); };
+        music_.win = audio(music_.winFile);
+        music_.lose = audio(music_.loseFile);
+    }
+
+    // Тела эллипсов заново выбранным построителем (тела из .upack тоже); сравнение в --headless
+    void rebuildEllipseBodies(const physics::EntityFactory::EllipseBuilder builder)
+    {
+        for (auto &[id, def] : objects_)
+            if (def.form.type == ObjectFormType::Ellipse)
+                def.body = physics::EntityFactory::makeEllipseTemplate(def.form.getRadii(), builder);
+    }
+
+    // Ссылка пакета на общий ресурс (один раз на ключ); true - ресурс уже в памяти, грузить не нужно
+    bool acquireTexture(core::managers::TextureManager &textures, const std::string &key)
+    {
+        return heldTextures_.insert(key).second ? textures.acquire(key) : textures.has(key);
+    }
+    bool acquireAudio(core::managers::AudioManager &audios, const std::string &key)
+    {
+        return heldAudios_.insert(key).second ? audios.acquire(key) : audios.has(key);
+    }
+
+    // Ссылка на атлас пакета в общем кэше (до unload); true - атлас уже на GPU, собирать и грузить не нужно
+    bool acquireAtlas(render::AtlasCache &atlases)
+    {
+        if (!atlases_)
+        {
+            atlases_ = &atlases;
+            sharedAtlas_ = atlases.acquire(packName_);
+        }
+        if (sharedAtlas_)
+            atlas_.clear();
+        return sharedAtlas_ != nullptr;
+    }
+
+    // После upload(): собственный атлас переходит в кэш, взятый acquireAtlas()
+    void shareAtlas()
+    {
+        if (atlases_ && !sharedAtlas_ && atlas_.pageCount() > 0)
+        {
+            sharedAtlas_ = atlases_->add(packName_, std::move(atlas_));
+            atlas_.clear();
+        }
+    }
+
     // GET METHODS
 
     bool empty() const
@@ -51,6 +125,17 @@ public:
         return objects_;
     }
 
+    // Текстуры объектов, если пакет грузился с атласом: из кэша или собственный
+    const render::TextureAtlas &getAtlas() const
+    {
+        return sharedAtlas_ ? *sharedAtlas_ : atlas_;
+    }
+    // Собственный атлас для сборки (загрузчики, упаковщик); после shareAtlas() пуст
+    render::TextureAtlas &getOwnAtlas()
+    {
+        return atlas_;
+    }
+
     const std::filesystem::path &getFolder() const
     {
         return folderAbs_;
@@ -76,16 +161,6 @@ public:
         packName_ = packName;
     }
 
-    void addTextureKey(const std::string &key)
-    {
-        textureKeys_.insert(key);
-    }
-    void addAudioKey(const std::string &key)
-    {
-        if(!key.empty())
-            audioKeys_.insert(key);
-    }
-
     void addObject(ObjectDef def)
     {
         objects_[def.id] = std::move(def);
@@ -111,8 +186,11 @@ private:
     std::unordered_map<IDType, ObjectDef> objects_;
     PackageSettings settings_;
     PackageMusic music_;
-    std::unordered_set<std::string> textureKeys_;
-    std::unordered_set<std::string> audioKeys_;
+    render::TextureAtlas atlas_;
+    render::AtlasCache *atlases_ = nullptr; // ссылка на атлас взята acquireAtlas, отпускается в unload
+    const render::TextureAtlas *sharedAtlas_ = nullptr;
+    std::unordered_set<std::string> heldTextures_; // взяты через acquire, отпускаются в unload
+    std::unordered_set<std::string> heldAudios_;
     IDType maxLevel_ = 0;
 };
 } // namespace resources
@@ -0,0 +1,295 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <SDL3/SDL_filesystem.h>
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_rect.h>
+#include <SDL3/SDL_surface.h>
+#include <SDL3_image/SDL_image.h>
+#include <pugixml/pugixml.hpp>
+
+#include <App/HardStrings.hpp>
+#include <App/IO/FullFileWorker.hpp>
+#include <App/IO/MappedFile.hpp>
+#include <App/Render/TextureAtlas.hpp>
+#include <Core/JobSystem.hpp>
+#include <Core/StringHashMap.hpp>
+#include <Core/StringUtils.hpp>
+
+namespace resources
+{
+
+// Карточка пакета для меню выбора: всё, что нужно показать, без разбора форм и загрузки картинок
+struct PackInfo
+{
+    std::string id;
+    std::string name;
+    unsigned int objectCount = 0;
+    unsigned int maxLevel = 0;
+    std::string thumbnail;    // картинка старшего объекта, относительно папки пакета
+    SDL_Rect thumbnailRect{}; // ячейка в атласе миниатюр, w == 0 - миниатюры нет
+    std::uint64_t hash = 0;   // config.xml + размер картинки миниатюры
+};
+
+// Индекс пакетов в рабочей папке (XML) и атлас миниатюр к нему (PNG).
+// При запуске у каждого пакета хэшируется только config.xml; разбираются и рисуются в атлас
+// лишь новые и изменённые пакеты. Меню показывает миниатюру как <img src="work:..." rect="...">.
+class PackIndex
+{
+public:
+    inline static constexpr const int thumbnailSize = 128;
+    inline static constexpr const int atlasColumns = 8;
+    inline static constexpr const unsigned int version = 1;
+
+public:
+    void setFiles(std::filesystem::path indexFile, std::filesystem::path atlasFile)
+    {
+        indexFile_ = std::move(indexFile);
+        atlasFile_ = std::move(atlasFile);
+    }
+
+    // Приводит индекс к пакетам ids; false - индекс или атлас не удалось сохранить
+    bool refresh(const std::filesystem::path &objectsRoot, const std::vector<std::string> &ids, core::JobSystem &jobs = core::JobSystem::instance())
+    {
+        std::vector<PackInfo> cached = readIndex();
+        render::SharedSurface oldAtlas;
+        if (!cached.empty())
+            oldAtlas = render::loadSurface(atlasFile_);
+        if (!oldAtlas)
+            cached.clear();
+
+        bool changed = false;
+        std::vector<PackInfo> packs;
+        std::vector<std::size_t> stale;
+        for (const std::string &id : ids)
+        {
+            const std::filesystem::path folder = objectsRoot / id;
+            IO::MappedFile config(folder / assets::packagConf);
+            if (config.empty())
+            {
+                SDL_Log("PackIndex: %s has no config", id.c_str());
+                continue;
+            }
+
+            // Хэш до разбора на месте: load_buffer_inplace портит буфер
+            const std::uint64_t configHash = core::fnv1a(config.view());
+            auto found = std::find_if(cached.begin(), cached.end(), [&id](const PackInfo &info) { return info.id == id; });
+            if (found != cached.end() && found->hash == contentHash(configHash, folder, found->thumbnail))
+            {
+                packs.push_back(std::move(*found));
+                continue;
+            }
+
+            PackInfo info;
+            info.id = id;
+            if (!readInfo(info, config))
+                continue;
+            info.hash = contentHash(configHash, folder, info.thumbnail);
+            stale.push_back(packs.size());
+            packs.push_back(std::move(info));
+            changed = true;
+        }
+
+        // Пакеты без config.xml не попадают ни в индекс, ни в сравнение - иначе индекс переписывался бы при каждом запуске
+        changed = changed || packs.size() != cached.size();
+
+        // Свободные ячейки атласа - новым и изменённым пакетам, у остальных ячейки прежние
+        std::vector<unsigned char> used;
+        auto cellOf = [](const SDL_Rect &rect) { return static_cast<std::size_t>(rect.y / thumbnailSize * atlasColumns + rect.x / thumbnailSize); };
+        for (const PackInfo &info : packs)
+            if (info.thumbnailRect.w > 0)
+            {
+                const std::size_t cell = cellOf(info.thumbnailRect);
+                used.resize(std::max(used.size(), cell + 1), 0);
+                used[cell] = 1;
+            }
+        for (const std::size_t ind : stale)
+        {
+            const std::size_t cell = std::find(used.begin(), used.end(), 0) - used.begin();
+            used.resize(std::max(used.size(), cell + 1), 0);
+            used[cell] = 1;
+            packs[ind].thumbnailRect = {static_cast<int>(cell % atlasColumns) * thumbnailSize, static_cast<int>(cell / atlasColumns) * thumbnailSize, thumbnailSize, thumbnailSize};
+        }
+
+        packs_ = std::move(packs);
+        ids_.clear();
+        for (std::size_t i = 0; i < packs_.size(); ++i)
+            ids_.emplace(packs_[i].id, i);
+        if (!changed)
+            return true;
+        return writeAtlas(objectsRoot, oldAtlas, stale, used.size(), jobs) && writeIndex();
+    }
+
+    const PackInfo *find(const std::string_view id) const
+    {
+        auto found = ids_.find(id);
+        return found == ids_.end() ? nullptr : &packs_[found->second];
+    }
+
+    const std::vector<PackInfo> &getAll() const
+    {
+        return packs_;
+    }
+
+private:
+    std::filesystem::path indexFile_;
+    std::filesystem::path atlasFile_;
+    std::vector<PackInfo> packs_;
+    core::StringHashMap<std::size_t> ids_;
+
+private:
+    static std::uint64_t contentHash(const std::uint64_t configHash, const std::filesystem::path &folder, const std::string &thumbnail)
+    {
+        // Размер вместо содержимого: картинку целиком ради проверки не читаем
+        SDL_PathInfo pathInfo{};
+        Uint64 size = 0;
+        if (!thumbnail.empty() && SDL_GetPathInfo((folder / thumbnail).string().c_str(), &pathInfo))
+            size = pathInfo.size;
+        return core::fnv1a(std::string_view(reinterpret_cast<const char *>(&size), sizeof(size)), core::fnv1a(thumbnail, configHash));
+    }
+
+    // Только атрибуты meta и filler, формы и звуки не нужны
+    static bool readInfo(PackInfo &info, IO::MappedFile &config)
+    {
+        pugi::xml_document doc;
+        if (auto res = doc.load_buffer_inplace(config.mutableData(), config.size()); !res)
+        {
+            SDL_Log("PackIndex: %s: xml parse error at offset %u", info.id.c_str(), (unsigned)res.offset);
+            return false;
+        }
+        const pugi::xml_node root = doc.child("root");
+        info.name = root.attribute("name").as_string(info.id.c_str());
+        for (const pugi::xml_node objectNode : root.child("objects").children("object"))
+        {
+            ++info.objectCount;
+            const unsigned int level = objectNode.child("meta").attribute("level").as_uint();
+            const pugi::xml_node filler = objectNode.child("filler");
+            if (level >= info.maxLevel)
+            {
+                info.maxLevel = level;
+                if (std::string_view(filler.attribute("type").as_string()) == "texture")
+                    info.thumbnail = filler.attribute("texture").as_string();
+            }
+        }
+        return info.objectCount > 0;
+    }
+
+    std::vector<PackInfo> readIndex() const
+    {
+        std::vector<PackInfo> res;
+        IO::MappedFile file(indexFile_);
+        pugi::xml_document doc;
+        if (file.empty() || !doc.load_buffer_inplace(file.mutableData(), file.size()))
+            return res;
+        const pugi::xml_node root = doc.child("packs");
+        if (root.attribute("version").as_uint() != version || root.attribute("thumbnailSize").as_int() != thumbnailSize)
+            return res;
+        for (const pugi::xml_node node : root.children("pack"))
+        {
+            PackInfo info;
+            info.id = node.attribute("id").as_string();
+            info.name = node.attribute("name").as_string();
+            info.objectCount = node.attribute("objects").as_uint();
+            info.maxLevel = node.attribute("maxLevel").as_uint();
+            info.thumbnail = node.attribute("thumbnail").as_string();
+            info.thumbnailRect = {node.attribute("x").as_int(), node.attribute("y").as_int(), node.attribute("w").as_int(), node.attribute("h").as_int()};
+            info.hash = node.attribute("hash").as_ullong();
+            res.push_back(std::move(info));
+        }
+        return res;
+    }
+
+    bool writeIndex() const
+    {
+        pugi::xml_document doc;
+        pugi::xml_node root = doc.append_child("packs");
+        root.append_attribute("version").set_value(version);
+        root.append_attribute("thumbnailSize").set_value(thumbnailSize);
+        for (const PackInfo &info : packs_)
+        {
+            pugi::xml_node node = root.append_child("pack");
+            node.append_attribute("id").set_value(info.id.c_str());
+            node.append_attribute("name").set_value(info.name.c_str());
+            node.append_attribute("objects").set_value(info.objectCount);
+            node.append_attribute("maxLevel").set_value(info.maxLevel);
+            node.append_attribute("thumbnail").set_value(info.thumbnail.c_str());
+            node.append_attribute("x").set_value(info.thumbnailRect.x);
+            node.append_attribute("y").set_value(info.thumbnailRect.y);
+            node.append_attribute("w").set_value(info.thumbnailRect.w);
+            node.append_attribute("h").set_value(info.thumbnailRect.h);
+            node.append_attribute("hash").set_value(static_cast<unsigned long long>(info.hash));
+        }
+        std::stringstream outStream;
+        doc.save(outStream);
+        return IO::writeAllFile(indexFile_, outStream.str());
+    }
+
+    // Старые ячейки копируются из прежнего атласа, картинки stale декодируются параллельно
+    bool writeAtlas(const std::filesystem::path &objectsRoot, const render::SharedSurface &oldAtlas, const std::vector<std::size_t> &stale, const std::size_t cells, core::JobSystem &jobs)
+    {
+        const int rows = static_cast<int>((std::max<std::size_t>(cells, 1) + atlasColumns - 1) / atlasColumns);
+        render::TextureAtlas::SurfacePtr atlas(SDL_CreateSurface(atlasColumns * thumbnailSize, rows * thumbnailSize, SDL_PIXELFORMAT_RGBA32));
+        if (!atlas)
+        {
+            SDL_Log("PackIndex: %s", SDL_GetError());
+            return false;
+        }
+        SDL_FillSurfaceRect(atlas.get(), nullptr, 0);
+        if (oldAtlas)
+            SDL_BlitSurface(oldAtlas.get(), nullptr, atlas.get(), nullptr);
+
+        std::vector<render::TextureAtlas::SurfacePtr> thumbnails(stale.size());
+        jobs.parallelFor(stale.size(),
+                         [&](const std::size_t i)
+                         {
+                             const PackInfo &info = packs_[stale[i]];
+                             if (info.thumbnail.empty())
+                                 return;
+                             const render::SharedSurface image = render::loadSurface(objectsRoot / info.id / info.thumbnail);
+                             if (!image || image->w <= 0 || image->h <= 0)
+                                 return;
+                             render::TextureAtlas::SurfacePtr thumb(SDL_CreateSurface(thumbnailSize, thumbnailSize, SDL_PIXELFORMAT_RGBA32));
+                             if (!thumb)
+                                 return;
+                             SDL_FillSurfaceRect(thumb.get(), nullptr, 0);
+                             // Вписываем с сохранением пропорций, по центру ячейки
+                             const float scale = static_cast<float>(thumbnailSize) / std::max(image->w, image->h);
+                             const int w = std::max(1, static_cast<int>(image->w * scale));
+                             const int h = std::max(1, static_cast<int>(image->h * scale));
+                             const SDL_Rect dst{(thumbnailSize - w) / 2, (thumbnailSize - h) / 2, w, h};
+                             if (SDL_BlitSurfaceScaled(image.get(), nullptr, thumb.get(), &dst, SDL_SCALEMODE_LINEAR))
+                                 thumbnails[i] = std::move(thumb);
+                         });
+
+        for (std::size_t i = 0; i < stale.size(); ++i)
+        {
+            PackInfo &info = packs_[stale[i]];
+            SDL_FillSurfaceRect(atlas.get(), &info.thumbnailRect, 0);
+            if (!thumbnails[i])
+            {
+                info.thumbnailRect = {};
+                continue;
+            }
+            SDL_SetSurfaceBlendMode(thumbnails[i].get(), SDL_BLENDMODE_NONE);
+            SDL_Rect dst = info.thumbnailRect;
+            SDL_BlitSurface(thumbnails[i].get(), nullptr, atlas.get(), &dst);
+        }
+
+        if (!IMG_SavePNG(atlas.get(), atlasFile_.string().c_str()))
+        {
+            SDL_Log("PackIndex: %s", SDL_GetError());
+            return false;
+        }
+        return true;
+    }
+};
+
+} // namespace resources
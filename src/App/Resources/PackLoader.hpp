@@ -0,0 +1,214 @@
+#pragma once
+
+#include <atomic>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_render.h>
+#include <SDLWrapper/Audio/Audio.hpp>
+
+#include <App/IO/ObjectPackIO.hpp>
+#include <App/IO/PackMediaDecoder.hpp>
+#include <App/IO/UPackIO.hpp>
+#include <App/Render/AtlasCache.hpp>
+#include <App/Render/ImageCache.hpp>
+#include <Core/JobSystem.hpp>
+#include <Core/Managers/AudioManager.hpp>
+#include <Core/Managers/TextureManager.hpp>
+
+#include "ObjectPack.hpp"
+
+namespace resources
+{
+
+enum class PackLoadState : unsigned char
+{
+    Idle,
+    Loading, // работает фоновый поток
+    Ready,   // фон закончил, осталось finish() в главном потоке
+    Failed
+};
+
+// Загрузка пакета в фоновом потоке: config.xml, декодирование картинок в страницы атласа и звуков.
+// Файлы декодируются параллельно (core::JobSystem); уже прогретые (ImageCache, AudioManager) пропускаются,
+// атлас из AtlasCache не собирается вовсе.
+// В главном потоке (finish) остаются только создание текстур страниц и перенос ресурсов в менеджеры.
+class PackLoader
+{
+public:
+    PackLoader() = default;
+    PackLoader(const PackLoader &) = delete;
+    PackLoader &operator=(const PackLoader &) = delete;
+    ~PackLoader()
+    {
+        cancel();
+    }
+
+    // atlasPageSize == 0 - без атласа, текстуры по одной грузятся в finish()
+    // images - уже декодированные картинки, atlases - атласы на GPU (оба могут быть nullptr),
+    // residentAudio - ключи звуков, которые есть в AudioManager
+    void start(std::string packName, std::filesystem::path folder, const bool loadMedia, const int atlasPageSize, render::ImageCache *images, render::AtlasCache *atlases, std::unordered_set<std::string> residentAudio)
+    {
+        cancel();
+        pack_ = {};
+        media_ = {};
+        upackData_.close();
+        decoded_ = {};
+        images_ = images;
+        atlases_ = atlasPageSize > 0 ? atlases : nullptr;
+        atlasCached_ = atlases_ && atlases_->has(packName);
+        residentAudio_ = std::move(residentAudio);
+        packName_ = std::move(packName);
+        done_ = 0;
+        total_ = 1;
+        cancelled_ = false;
+        state_ = PackLoadState::Loading;
+        worker_ = std::thread(
+            [this, folder = std::move(folder), loadMedia, atlasPageSize]()
+            {
+                state_.store(work(folder, loadMedia, atlasPageSize) ? PackLoadState::Ready : PackLoadState::Failed, std::memory_order_release);
+            });
+    }
+
+    // Останавливает фоновый поток, результат выбрасывается
+    void cancel()
+    {
+        cancelled_ = true;
+        if (worker_.joinable())
+            worker_.join();
+        state_ = PackLoadState::Idle;
+    }
+
+    PackLoadState getState() const
+    {
+        return state_.load(std::memory_order_acquire);
+    }
+
+    const std::string &getPackName() const
+    {
+        return packName_;
+    }
+
+    // Доля обработанных файлов, 0..1
+    float getProgress() const
+    {
+        const unsigned int total = total_.load(std::memory_order_relaxed);
+        return total == 0 ? 1.f : static_cast<float>(done_.load(std::memory_order_relaxed)) / total;
+    }
+
+    // Главный поток, после getState() == Ready: GPU-загрузка и перенос ресурсов в pack и менеджеры
+    bool finish(ObjectPack &pack, core::managers::TextureManager &textures, core::managers::AudioManager &audios, SDL_Renderer *renderer)
+    {
+        if (worker_.joinable())
+            worker_.join();
+        if (state_ != PackLoadState::Ready)
+            return false;
+        state_ = PackLoadState::Idle;
+
+        // Атлас мог уйти из кэша после start(): тогда недостающие текстуры грузятся по одной
+        if (renderer && !(atlases_ && pack_.acquireAtlas(*atlases_)))
+        {
+            if (!pack_.getOwnAtlas().upload(renderer))
+                SDL_Log("Atlas of pack %s is incomplete", packName_.c_str());
+            pack_.shareAtlas();
+        }
+        const render::TextureAtlas &atlas = pack_.getAtlas();
+        for (const auto &[key, file] : media_.textures)
+            if (!atlas.find(key) && !pack_.acquireTexture(textures, key) && !textures.load(key, file))
+            {
+                pack_.unload(textures, audios);
+                return false;
+            }
+        // Ссылки до добавления: add() может выгружать по бюджету, звуки пакета с ссылками он не тронет
+        for (const auto &file : media_.audios)
+            pack_.acquireAudio(audios, file.first);
+        for (auto &[key, audio, bytes] : decoded_.audios)
+            if (!audios.has(key))
+                audios.add(key, std::move(audio), bytes);
+        // Звук был в памяти при start(), но его успели выгрузить
+        for (const auto &[key, file] : media_.audios)
+            if (residentAudio_.contains(key) && !audios.has(key) && !audios.load(key, file))
+                SDL_Log("Failed to load sound %s", file.string().c_str());
+        if (images_)
+            for (auto &[key, surface] : decoded_.images)
+                images_->add(key, std::move(surface));
+        decoded_ = {};
+
+        pack = std::move(pack_);
+        upackData_.close();
+        pack_ = {};
+        return true;
+    }
+
+private:
+    std::thread worker_;
+    std::atomic<PackLoadState> state_ = PackLoadState::Idle;
+    std::atomic<bool> cancelled_ = false;
+    std::atomic<unsigned int> done_ = 0;
+    std::atomic<unsigned int> total_ = 1;
+
+    // Пишет только фоновый поток, читает главный после join
+    std::string packName_;
+    ObjectPack pack_;
+    IO::PackMediaFiles media_;
+    IO::MappedFile upackData_; // страницы атласа из .upack ссылаются сюда до upload()
+    IO::DecodedPackMedia decoded_;
+    render::ImageCache *images_ = nullptr;
+    render::AtlasCache *atlases_ = nullptr;
+    bool atlasCached_ = false; // атлас пакета уже на GPU, картинки не декодируются
+    std::unordered_set<std::string> residentAudio_;
+
+private:
+    bool work(const std::filesystem::path &folder, const bool loadMedia, const int atlasPageSize)
+    {
+        if (!IO::upack::loadPackDefinition(pack_, media_, upackData_, packName_, folder, loadMedia, atlasPageSize > 0 || !loadMedia, atlasPageSize))
+        {
+            SDL_Log("PackLoader: failed to parse %s", packName_.c_str());
+            return false;
+        }
+
+        // Декодировать нужно только то, чего ещё нет в памяти. Картинки из кэша берутся сразу:
+        // между проверкой и сборкой атласа кэш может их вытеснить
+        const bool composeAtlas = atlasPageSize > 0 && !atlasCached_;
+        IO::PackMediaFiles toDecode;
+        std::vector<std::pair<std::string, render::SharedSurface>> cached;
+        if (composeAtlas)
+            for (const auto &file : media_.textures)
+            {
+                if (pack_.getOwnAtlas().contains(file.first)) // уже на странице из .upack
+                    continue;
+                if (render::SharedSurface surface = images_ ? images_->find(file.first) : nullptr)
+                    cached.emplace_back(file.first, std::move(surface));
+                else
+                    toDecode.textures.push_back(file);
+            }
+        for (const auto &file : media_.audios)
+            if (!residentAudio_.contains(file.first))
+                toDecode.audios.push_back(file);
+
+        total_ = static_cast<unsigned int>(1 + toDecode.textures.size() + toDecode.audios.size());
+        done_ = 1;
+        decoded_ = IO::decodePackMedia(toDecode, core::JobSystem::instance(), &done_, &cancelled_);
+        if (cancelled_)
+            return false;
+
+        if (composeAtlas)
+        {
+            render::TextureAtlas &atlas = pack_.getOwnAtlas();
+            for (const auto &[key, surface] : decoded_.images)
+                atlas.add(key, surface);
+            for (auto &[key, surface] : cached)
+                atlas.add(key, std::move(surface));
+            if (!atlas.compose(atlasPageSize))
+                SDL_Log("PackLoader: atlas of pack %s is incomplete", packName_.c_str());
+        }
+        return true;
+    }
+};
+
+} // namespace resources
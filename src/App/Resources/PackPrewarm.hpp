@@ -0,0 +1,88 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_timer.h>
+
+#include <App/IO/ObjectPackIO.hpp>
+#include <App/IO/PackMediaDecoder.hpp>
+#include <App/IO/UPackIO.hpp>
+#include <App/Render/ImageCache.hpp>
+#include <Core/JobSystem.hpp>
+#include <Core/Managers/AudioManager.hpp>
+
+#include "ObjectPack.hpp"
+
+namespace resources
+{
+
+struct PrewarmReport
+{
+    std::size_t packs = 0;
+    std::size_t images = 0;
+    std::size_t audios = 0;
+    Uint64 totalNS = 0;
+    Uint64 longestNS = 0; // самый долгий файл - нижняя граница totalNS
+};
+
+// Декодирует картинки и звуки всех пакетов параллельно (core::JobSystem) и отдаёт их одной пачкой:
+// звуки - в AudioManager, картинки - в ImageCache (текстуры из них соберёт PackLoader).
+inline PrewarmReport prewarmPacks(const std::filesystem::path &objectsRoot, const std::vector<std::string> &packNames, render::ImageCache &images, core::managers::AudioManager &audios, core::JobSystem &jobs = core::JobSystem::instance())
+{
+    PrewarmReport report;
+    const Uint64 start = SDL_GetTicksNS();
+
+    std::vector<IO::PackMediaFiles> packMedia(packNames.size());
+    std::vector<unsigned char> parsed(packNames.size(), 0);
+    jobs.parallelFor(packNames.size(),
+                     [&](const std::size_t i)
+                     {
+                         IO::MappedFile upack;
+                         ObjectPack pack;
+                         parsed[i] = IO::upack::loadPackDefinition(pack, packMedia[i], upack, packNames[i], objectsRoot / packNames[i], true);
+                         if (!parsed[i])
+                             SDL_Log("Prewarm: failed to parse %s", packNames[i].c_str());
+                         // Картинки со страниц .upack декодировать незачем
+                         std::erase_if(packMedia[i].textures, [&pack](const auto &file) { return pack.getOwnAtlas().contains(file.first); });
+                     });
+
+    IO::PackMediaFiles all;
+    std::unordered_set<std::string> textureKeys;
+    std::unordered_set<std::string> audioKeys = audios.keys();
+    for (std::size_t i = 0; i < packMedia.size(); ++i)
+    {
+        if (!parsed[i])
+            continue;
+        ++report.packs;
+        for (const auto &file : packMedia[i].textures)
+            if (!images.find(file.first) && textureKeys.insert(file.first).second)
+                all.textures.push_back(file);
+        for (const auto &file : packMedia[i].audios)
+            if (audioKeys.insert(file.first).second)
+                all.audios.push_back(file);
+    }
+
+    IO::DecodedPackMedia decoded = IO::decodePackMedia(all, jobs);
+    for (auto &[key, surface] : decoded.images)
+        images.add(key, std::move(surface));
+    for (auto &[key, audio, bytes] : decoded.audios)
+        audios.add(key, std::move(audio), bytes);
+
+    report.images = decoded.images.size();
+    report.audios = decoded.audios.size();
+    report.longestNS = decoded.longestNS;
+    report.totalNS = SDL_GetTicksNS() - start;
+    return report;
+}
+
+inline void logReport(const PrewarmReport &report)
+{
+    SDL_Log("Prewarm: %zu packs, %zu images, %zu sounds in %.1f ms (longest file %.1f ms, %u threads)",
+            report.packs, report.images, report.audios, report.totalNS / 1e6, report.longestNS / 1e6, core::JobSystem::instance().threadCount());
+}
+
+} // namespace resources
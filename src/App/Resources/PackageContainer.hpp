@@ -5,9 +5,11 @@
 #include <unordered_map>
 
 #include <App/IO/ObjectPackIO.hpp>
+#include <App/IO/UPackIO.hpp>
 
 #include "Core/Managers/AudioManager.hpp"
 #include "ObjectPack.hpp"
+#include "PackLoader.hpp"
 #include <Core/Managers/TextureManager.hpp>
 
 namespace resources
@@ -20,6 +22,13 @@ public:
         : objectsRoot_(std::move(objectsRoot)), textures_(textures), audios_(audios)
     {
     }
+    PackageContainer(const PackageContainer &) = delete;
+    PackageContainer &operator=(const PackageContainer &) = delete;
+    // Ресурсы пакетов остаются в менеджерах до вытеснения по бюджету - следующая игра их переиспользует
+    ~PackageContainer()
+    {
+        unloadAll();
+    }
 
     core::managers::TextureManager &textures()
     {
@@ -38,6 +47,30 @@ public:
         return audios_;
     }
 
+    // false - пакеты грузятся без текстур и звуков (headless режим)
+    void setLoadMedia(const bool loadMedia)
+    {
+        loadMedia_ = loadMedia;
+    }
+
+    // Текстуры объектов собираются в атлас на этом renderer. nullptr - по одной текстуре.
+    void setAtlasRenderer(SDL_Renderer *renderer)
+    {
+        atlasRenderer_ = renderer;
+    }
+
+    // Декодированные картинки, общие для всех загрузок (прогрев пакетов). nullptr - без кэша.
+    void setImageCache(render::ImageCache *images)
+    {
+        images_ = images;
+    }
+
+    // Атласы на GPU, общие для всех сцен: пакет, в который вернулись, берёт свой атлас оттуда. nullptr - атлас свой у пакета.
+    void setAtlasCache(render::AtlasCache *atlases)
+    {
+        atlases_ = atlases;
+    }
+
     bool loadFolder(const std::string &packName)
     {
         return loadByOtherPath(objectsRoot_ / packName, packName);
@@ -46,27 +79,78 @@ public:
     bool loadByOtherPath(const std::filesystem::path &folderAbs, const std::string packName)
     {
         auto &pack = packs_[packName];
-        if (!IO::readObjectPack(pack, textures_, audios_, packName, folderAbs))
+        pack.unload(textures_, audios_);
+        IO::PackMediaFiles media;
+        IO::MappedFile upack;
+        bool loaded = IO::upack::loadPackDefinition(pack, media, upack, packName, folderAbs, loadMedia_, atlasRenderer_ || !loadMedia_,
+                                                    atlasRenderer_ ? render::TextureAtlas::pageSizeFor(atlasRenderer_) : 0);
+        // Атлас из кэша - loadPackMedia его не собирает
+        if (loaded && loadMedia_ && atlasRenderer_ && atlases_)
+            pack.acquireAtlas(*atlases_);
+        loaded = loaded && IO::loadPackMedia(pack, textures_, audios_, media, atlasRenderer_);
+        if (!loaded)
         {
+            pack.unload(textures_, audios_);
             packs_.erase(packName);
             return false;
         }
+        pack.resolveHandles(textures_, audios_);
         return true;
     }
 
+    // Фоновая загрузка пакета. Пакет появится в контейнере после pollLoad() == Ready.
+    void beginLoadFolder(const std::string &packName)
+    {
+        loader_.start(packName, objectsRoot_ / packName, loadMedia_, atlasRenderer_ ? render::TextureAtlas::pageSizeFor(atlasRenderer_) : 0, images_, atlases_, audios_.keys());
+    }
+
+    // Вызывается каждый кадр, пока идёт загрузка. Ready/Failed возвращается один раз.
+    PackLoadState pollLoad()
+    {
+        const PackLoadState state = loader_.getState();
+        if (state == PackLoadState::Failed)
+            loader_.cancel();
+        if (state != PackLoadState::Ready)
+            return state;
+
+        const std::string packName = loader_.getPackName();
+        ObjectPack &pack = packs_[packName];
+        pack.unload(textures_, audios_);
+        if (!loader_.finish(pack, textures_, audios_, atlasRenderer_))
+        {
+            packs_.erase(packName);
+            return PackLoadState::Failed;
+        }
+        pack.resolveHandles(textures_, audios_);
+        return PackLoadState::Ready;
+    }
+
+    float getLoadProgress() const
+    {
+        return loader_.getProgress();
+    }
+
     void unloadFolder(const std::string &packName)
     {
         auto it = packs_.find(packName);
         if (it == packs_.end())
             return;
+        it->second.unload(textures_, audios_);
         packs_.erase(it);
     }
 
     void unloadAll()
     {
+        for (auto &[name, pack] : packs_)
+            pack.unload(textures_, audios_);
         packs_.clear();
     }
 
+    ObjectPack *getPack(const std::string packName)
+    {
+        auto it = packs_.find(packName);
+        return it == packs_.end() ? nullptr : &it->second;
+    }
     const ObjectPack *getPack(const std::string packName) const
     {
         auto it = packs_.find(packName);
@@ -91,6 +175,11 @@ private:
     core::managers::TextureManager &textures_;
     core::managers::AudioManager &audios_;
     std::unordered_map<std::string, ObjectPack> packs_;
+    bool loadMedia_ = true;
+    SDL_Renderer *atlasRenderer_ = nullptr;
+    render::ImageCache *images_ = nullptr;
+    render::AtlasCache *atlases_ = nullptr;
+    PackLoader loader_;
 };
 
 } // namespace resources
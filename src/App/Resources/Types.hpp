@@ -1,5 +1,6 @@
 #pragma once
 
+#include <filesystem>
 #include <string>
 #include <variant>
 #include <vector>
@@ -7,6 +8,9 @@
 #include <SDLWrapper/Math/Colors.hpp>
 #include <SDLWrapper/Names.hpp>
 
+#include <App/Physics/BodyTemplate.hpp>
+#include <App/Render/Mesh.hpp>
+#include <Core/Managers/ResourceHandle.hpp>
 #include <Core/Types.hpp>
 
 namespace resources
@@ -53,11 +57,12 @@ public:
             return std::get<sdl3::Vector2f>(form);
         return {0.f, 0.f};
     }
-    std::vector<sdl3::Vector2f> getPolygon() const
+    const std::vector<sdl3::Vector2f> &getPolygon() const
     {
+        static const std::vector<sdl3::Vector2f> empty;
         if (std::holds_alternative<std::vector<sdl3::Vector2f>>(form))
             return std::get<std::vector<sdl3::Vector2f>>(form);
-        return {};
+        return empty;
     }
 };
 
@@ -71,11 +76,12 @@ public:
     std::variant<std::string, sdl3::Color> filler = sdl3::Colors::White;
 
 public:
-    std::string getTextureName() const
+    const std::string &getTextureName() const
     {
+        static const std::string empty;
         if (std::holds_alternative<std::string>(filler))
             return std::get<std::string>(filler);
-        return {};
+        return empty;
     }
     sdl3::Color getColor() const
     {
@@ -94,6 +100,17 @@ struct ObjectDef
     ObjectFormDef form;
     ObjectFillerDef filler;
     std::string soundFile;
+
+    // Разрешаются после загрузки пакета (ObjectPack::resolveHandles), на спавне и звуке строк нет
+    core::managers::TextureHandle texture;
+    core::managers::AudioHandle sound;
+    SDL_Texture *atlasPage = nullptr; // nullptr - текстура не в атласе
+    SDL_FRect atlasUV = {0.f, 0.f, 1.f, 1.f};
+
+    // Геометрия тела, считается при загрузке пакета
+    physics::BodyTemplate body;
+    // Треугольники для отрисовки, считаются при загрузке пакета
+    render::Mesh mesh;
 };
 
 struct PackageMusic
@@ -101,6 +118,10 @@ struct PackageMusic
     std::string backgroundFile;
     std::string winFile;
     std::string loseFile;
+
+    std::filesystem::path backgroundPath; // играет потоком (audio::MusicStream), мимо AudioManager
+    core::managers::AudioHandle win;
+    core::managers::AudioHandle lose;
 };
 
 struct PackageSettings
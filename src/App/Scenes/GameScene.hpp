@@ -5,6 +5,8 @@
 #include "Resources/Types.hpp"
 #include <SDLWrapper/Audio/Sound.hpp>
 #include <memory>
+#include <optional>
+#include <vector>
 
 #include <SDL3/SDL_events.h>
 #include <SDL3/SDL_keycode.h>
@@ -20,15 +22,14 @@
 #include <RmlUi/Core/EventListener.h>
 #include <RmlUi/Core/ID.h>
 
-#include <App/AppEvents.hpp>
 #include <App/AppState.hpp>
-#include <App/GameObjects/GameContactCheker.hpp>
+#include <App/Audio/MusicStream.hpp>
+#include <App/GameObjects/GameSimulation.hpp>
 #include <App/HardStrings.hpp>
-#include <App/Physics/EntityFactory.hpp>
+#include <App/Render/SpriteBatch.hpp>
 #include <App/Resources/ObjectFactory.hpp>
 #include <App/Statistic/GameStatistic.hpp>
 #include <Core/Managers/PathMeneger.hpp>
-#include <Core/Random.hpp>
 #include <Engine/AdvancedContext.hpp>
 #include <Engine/OneRmlDocScene.hpp>
 #include <unordered_map>
@@ -91,36 +92,17 @@ public:
         listener_(*this),
         appState_(appState),
         packages_(core::managers::PathManager::assets() / assets::packages, appState_.textures(), appState.audios()),
-        objectFactory_(packages_)
+        objectFactory_(packages_),
+        sim_(objectFactory_)
     {
-        if (!objectFactory_.loadPack(appState.getCurrentPackageName()))
+        packages_.setAtlasRenderer(context.getRenderer());
+        packages_.setImageCache(&appState.images());
+        packages_.setAtlasCache(&appState.atlases());
+        // Пакет грузится в фоне, игра начнётся в onPackLoaded()
+        if (!objectFactory_.beginLoadPack(appState.getCurrentPackageName()))
             SDL_Log("Failed to load object pack: %s", appState.getCurrentPackageName().c_str());
-        if (const auto *gs = appState_.stat().findById(objectFactory_.getActivePack()))
-            stat_.record = static_cast<int>(gs->record);
-        if (auto pack = packages_.getPack(objectFactory_.getActivePack()); pack)
-            settings_ = pack->getSetings();
-
-        objectFactory_.loadSounds(sounds_);//Не все могут быть загружены
-
-        auto activePack = packages_.getPack(objectFactory_.getActivePack());
-        if(activePack)
-        {
-            auto mus = activePack->getMusic();
-            auto loseAudio = packages_.audios().get(mus.loseFile);
-            auto winAudio = packages_.audios().get(mus.winFile);
-            auto backAudio = packages_.audios().get(mus.backgroundFile);
-            if(loseAudio)
-                loseSound_.setAudio(*loseAudio);
-            if(winAudio)
-                winSound_.setAudio(*winAudio);
-            if(backAudio)
-            {
-                backMusic_.setAudio(*backAudio);
-                sdl3::audio::PlayProperties prop = sdl3::audio::PlayProperties::getDefaultProperties();
-                prop.loopCount = -1;
-                audio_.playSound(backMusic_, prop);
-            }
-        }
+        stat_.stringID = objectFactory_.getActivePack();
+        statId_ = appState.stat().idOf(stat_.stringID);
 
         bindData();
         loadDocumentOrThrow();
@@ -128,19 +110,15 @@ public:
         gameOverOverlay = document()->GetElementById(ui::gameMenu::gameOverOverlayId);
         pauseOverlay = document()->GetElementById(ui::gameMenu::pauseOverlayId);
         winOverlay = document()->GetElementById(ui::gameMenu::winOverOverlayId);
+        loadingOverlay = document()->GetElementById(ui::gameMenu::loadingOverlayId);
 
-        world_.SetContactListener(&contactCheker_);
-        generateGlass(logicSize, {(float)logicSize.x, (float)logicSize.y * 0.75f}, 30);
-
-        stat_.stringID = objectFactory_.getActivePack();
-
-        timer_.start();
-        startTimer_.start();
+        sim_.generateGlass(logicSize, {(float)logicSize.x, (float)logicSize.y * 0.75f}, 30);
     }
     ~GameScene()
     {
-        backMusic_.stop();
-        applyStatistic();
+        backMusic_.close();
+        if (!loading_)
+            applyStatistic();
         if (dataHandle_)
         {
             dataHandle_ = Rml::DataModelHandle(); // Освобождаем модель данных
@@ -153,42 +131,49 @@ public:
     {
         if (paused_)
             return;
-        if (event.type == app::AppEventsType::COLLISION)
-            updateCollision(event);
-        else if (event.type == SDL_EVENT_KEY_DOWN && event.key.scancode == SDL_SCANCODE_AC_BACK)
+        if (event.type == SDL_EVENT_KEY_DOWN && event.key.scancode == SDL_SCANCODE_AC_BACK)
             actionRes_ = engine::SceneAction::popAction();
+        else if (loading_)
+            return;
         else if (event.type == SDL_EVENT_MOUSE_BUTTON_UP)
         {
-            if (event.button.y < startPoss_.y)
+            if (event.button.y < sim_.getStartPosition().y)
                 return;
             startEntityObject(event.button.x);
         }
         else if (event.type == SDL_EVENT_MOUSE_MOTION)
         {
-            if (event.button.y < startPoss_.y)
+            if (event.button.y < sim_.getStartPosition().y)
                 return;
-            if (prEntity_)
-                prEntity_->setPosition({event.motion.x, startPoss_.y});
+            sim_.movePreview(event.motion.x);
         }
     }
 
     void draw(sdl3::RenderWindow &window) const override
     {
-        for (const auto &i : glass_)
-            window.draw(i);
-        for (const auto &i : objects_)
-            window.draw(i);
-        if (prEntity_)
-            window.draw(prEntity_.get());
+        batch_.begin();
+        for (const auto &i : sim_.getGlass())
+            drawEntity(window, i);
+        for (const auto &i : sim_.getObjects())
+            drawEntity(window, i);
+        if (const auto *preview = sim_.getPreview())
+            drawEntity(window, *preview);
+        batch_.flush(window.getNativeSDLRenderer().get());
     }
 
     engine::SceneAction update(const float dt) override
     {
-        if (paused_)
+        if (loading_)
+            updateLoading();
+        if (paused_ || loading_)
             return engine::OneRmlDocScene::update(dt);
-        if (!prEntity_ && startTimer_.elapsedTimeS() >= settings_.summonTimeStepS)
+        if (!sim_.getPreview() && startTimer_.elapsedTimeS() >= settings_.summonTimeStepS)
             createPrEntity();
-        world_.Step(dt, 8, 3);
+        sim_.advance(dt,
+                     [this](const objects::MergeResult &merged)
+                     {
+                         onMerged(merged);
+                     });
         updateTime();
         updatecorrectnessElements();
         return engine::OneRmlDocScene::update(dt);
@@ -201,39 +186,96 @@ private: // Сцена
     Rml::Element *gameOverOverlay = nullptr;
     Rml::Element *pauseOverlay = nullptr;
     Rml::Element *winOverlay = nullptr;
+    Rml::Element *loadingOverlay = nullptr;
+    bool loading_ = true;
+    int loadPercent_ = 0;
 
 private: // Аудио
 
     sdl3::audio::AudioDevice &audio_;
-    std::unordered_map<IDType, sdl3::audio::Sound> sounds_;
+    std::vector<std::optional<sdl3::audio::Sound>> sounds_; // по id объекта
 
     sdl3::audio::Sound winSound_;
     sdl3::audio::Sound loseSound_;
-    sdl3::audio::Sound backMusic_;
+    audio::MusicStream backMusic_; // длинный трек не декодируется целиком
 
 private: // Информация на экране
     Rml::DataModelHandle dataHandle_;
     statistic::GameStatistic stat_;
+    statistic::GameID statId_ = statistic::noGame;
     sdl3::Clock timer_;
     unsigned countDeath_ = 0;
     bool isWin_ = false;
 
-private: // Физический мир
-    b2World world_{b2Vec2(0.0f, 9.81f)};
-    objects::GameContactCheker contactCheker_;
-    std::vector<physics::Entity> glass_;
-    std::vector<objects::GameObject> objects_;
-
 private: // Информация о пакете
     resources::PackageContainer packages_;
     resources::ObjectFactory objectFactory_;
     resources::PackageSettings settings_;
 
+private: // Физический мир
+    objects::GameSimulation sim_;
+    mutable render::SpriteBatch batch_;
+
 private: // Временный объект
     sdl3::Clock startTimer_;
-    std::unique_ptr<objects::GameObject> prEntity_ = nullptr;
-    sdl3::Vector2f startPoss_;
-    core::Random<IDType> random_;
+
+private: // Загрузка пакета
+    void updateLoading()
+    {
+        const resources::PackLoadState state = packages_.pollLoad();
+        if (state == resources::PackLoadState::Loading)
+        {
+            const int percent = static_cast<int>(packages_.getLoadProgress() * 100.f);
+            if (percent != loadPercent_)
+            {
+                loadPercent_ = percent;
+                dataHandle_.DirtyVariable(ui::gameMenu::loadingLabel);
+            }
+            return;
+        }
+        loading_ = false;
+        if (loadingOverlay)
+            loadingOverlay->SetClass(ui::gameMenu::openClass, false);
+        if (state != resources::PackLoadState::Ready)
+        {
+            SDL_Log("Failed to load object pack: %s", objectFactory_.getActivePack().c_str());
+            actionRes_ = engine::SceneAction::popAction();
+            return;
+        }
+        onPackLoaded();
+    }
+
+    // Всё, что зависит от ресурсов пакета
+    void onPackLoaded()
+    {
+        appState_.logCacheStats();
+        if (const auto *gs = appState_.stat().get(statId_))
+            stat_.record = static_cast<int>(gs->record);
+        if (auto pack = packages_.getPack(objectFactory_.getActivePack()); pack)
+            settings_ = pack->getSetings();
+        sim_.setSettings(settings_);
+        dataHandle_.DirtyVariable(ui::gameMenu::recordLabel);
+        dataHandle_.DirtyVariable(ui::gameMenu::maxDeathLabel);
+
+        objectFactory_.loadSounds(sounds_);//Не все могут быть загружены
+
+        auto activePack = packages_.getPack(objectFactory_.getActivePack());
+        if(activePack)
+        {
+            const auto &mus = activePack->getMusic();
+            auto loseAudio = packages_.audios().get(mus.lose);
+            auto winAudio = packages_.audios().get(mus.win);
+            if(loseAudio)
+                loseSound_.setAudio(*loseAudio);
+            if(winAudio)
+                winSound_.setAudio(*winAudio);
+            if(!mus.backgroundPath.empty() && backMusic_.open(mus.backgroundPath))
+                backMusic_.play(appState_.getVolume());
+        }
+
+        timer_.start();
+        startTimer_.start();
+    }
 
 private: // Сцена
     void setPause(const bool pause, const bool openPauseMenu = true)
@@ -253,7 +295,6 @@ private: // Сцена
         applyStatistic();
         setPause(false);
 
-        prEntity_.reset();
         startTimer_.start();
 
         countDeath_ = 0;
@@ -261,7 +302,7 @@ private: // Сцена
         timer_.start();
         startTimer_.start();
         stat_.gameCount = 0;
-        objects_.clear();
+        sim_.clear();
 
         updateTime();
         addPoints(0);
@@ -272,7 +313,7 @@ private: // Сцена
 
     void applyStatistic()
     {
-        appState_.stat().applyGameResult(stat_.stringID, stat_);
+        appState_.applyGameResult(statId_, stat_);
     }
 
     void bindData()
@@ -285,6 +326,7 @@ private: // Сцена
             constructor.Bind(ui::gameMenu::recordLabel, &stat_.record);
             constructor.Bind(ui::gameMenu::deathLabel, &countDeath_);
             constructor.Bind(ui::gameMenu::maxDeathLabel, &settings_.deathCount);
+            constructor.Bind(ui::gameMenu::loadingLabel, &loadPercent_);
         }
         dataHandle_ = constructor.GetModelHandle();
     }
@@ -315,37 +357,19 @@ private: // Сцена
     }
 
 private: // Физический мир
-    void generateGlass(const sdl3::Vector2i logicSize, const sdl3::Vector2f glassSize, const float thikness)
+    // Сущности с мешем уходят в batch_, остальные рисуются сразу
+    void drawEntity(sdl3::RenderWindow &window, const physics::Entity &entity) const
     {
-        glass_.clear();
-
-        float yPos = logicSize.y;
-
-        glass_.push_back(physics::EntityFactory::createRectangle(world_, {logicSize.x / 2.f, yPos}, {glassSize.x, thikness}, sdl3::Colors::Black, nullptr, b2BodyType::b2_staticBody));
-        glass_.push_back(physics::EntityFactory::createRectangle(world_, {logicSize.x / 2.f - glassSize.x / 2.f, yPos - glassSize.y / 2.f}, {thikness, glassSize.y}, sdl3::Colors::Black, nullptr, b2BodyType::b2_staticBody));
-        glass_.push_back(physics::EntityFactory::createRectangle(world_, {logicSize.x / 2.f + glassSize.x / 2.f, yPos - glassSize.y / 2.f}, {thikness, glassSize.y}, sdl3::Colors::Black, nullptr, b2BodyType::b2_staticBody));
-
-        startPoss_ =
-            {
-                logicSize.x / 2.f,
-                (yPos - (glassSize.y)) / 2.f};
-    }
-
-    std::size_t getByID(const IDType id)
-    {
-        for (std::size_t i = 0; i < objects_.size(); ++i)
-            if (objects_[i].getID() == id)
-                return i;
-        return objects_.size();
+        if (!batch_.add(entity))
+            window.draw(entity);
     }
 
     void playSound(const resources::ObjectDef *def)
     {
-        auto found = sounds_.find(def->id);
-        if(found == sounds_.end())
+        if (def->id >= sounds_.size() || !sounds_[def->id])
             return;
-        
-        audio_.playSound(found->second);
+
+        audio_.playSound(*sounds_[def->id]);
     }
 
     void checkWin(const IDType idSummonedObject)
@@ -363,81 +387,37 @@ private: // Физический мир
         isWin_ = true;
     }
 
-    void updateCollision(const SDL_Event &event)
+    void onMerged(const objects::MergeResult &merged)
     {
-        std::size_t obj1Ind = getByID(static_cast<IDType>(reinterpret_cast<uintptr_t>(event.user.data1)));
-        std::size_t obj2Ind = getByID(static_cast<IDType>(reinterpret_cast<uintptr_t>(event.user.data2)));
-        if (obj1Ind == objects_.size() || obj2Ind == objects_.size())
+        checkWin(merged.mergedId);
+        if (!merged.def)
             return;
-
-        objects::GameObject &obj1 = objects_[obj1Ind];
-        objects::GameObject &obj2 = objects_[obj2Ind];
-
-        const IDType level1 = obj1.getLevel();
-        const IDType level2 = obj2.getLevel();
-
-        const auto mergedIdOpt = objectFactory_.getMergeResultId(level1, level2);
-        if (!mergedIdOpt)
-            return;
-
-        checkWin(*mergedIdOpt);
-
-        sdl3::Vector2f pos = (obj1.getShape().getPosition() + obj2.getShape().getPosition()) / 2.f;
-
-        objects_.erase(objects_.begin() + std::max(obj1Ind, obj2Ind));
-        objects_.erase(objects_.begin() + std::min(obj1Ind, obj2Ind));
-
-        const resources::ObjectDef *def = objectFactory_.getDefById(*mergedIdOpt);
-        auto created = objectFactory_.create(world_, def, pos);
-        if (!created)
-            return;
-        playSound(def);
-
-        objects_.push_back(std::move(*created));
-        addPoints(objects_.back().getPoints());
+        playSound(merged.def);
+        addPoints(merged.points);
     }
 
     void updatecorrectnessElements()
     {
-        for (auto it = objects_.begin(); it != objects_.end();)
-        {
-            if (it->getPosition().y > 2000.f)
+        sim_.removeFallen(
+            [this](const int points)
             {
-                addPoints(-it->getPoints());
-                it = objects_.erase(it); // erase возвращает итератор на следующий элемент
+                addPoints(-points);
                 addCountDeath();
-            }
-            else
-                ++it;
-        }
+            });
     }
 
 private: // Временный объект
     void createPrEntity()
     {
-        IDType level = random_(settings_.levelRange.x, settings_.levelRange.y);
-        auto idpt = objectFactory_.getIdByLevel(level);
-        if (!idpt.has_value())
-        {
-            SDL_Log("Error! Not found object by level %d\n", static_cast<int>(level));
+        if (!sim_.createPreview())
             actionRes_ = engine::SceneAction::popAction();
-        }
-        auto created = objectFactory_.createById(world_, idpt.value(), {startPoss_.x, -startPoss_.y});
-        if (!created)
-            return;
-
-        prEntity_ = std::make_unique<objects::GameObject>(std::move(*created));
-        prEntity_->setEnabled(false);
     }
     void startEntityObject(const float xPos)
     {
-        if (!prEntity_ || startTimer_.elapsedTimeS() < settings_.summonTimeStepS)
+        if (!sim_.getPreview() || startTimer_.elapsedTimeS() < settings_.summonTimeStepS)
             return;
-        prEntity_->setPosition({xPos, startPoss_.y});
-        prEntity_->setEnabled(true);
-        addPoints(prEntity_->getPoints());
-        objects_.push_back(std::move(*prEntity_.get()));
-        prEntity_.reset();
+        const objects::GameObject *dropped = sim_.drop(xPos);
+        addPoints(dropped->getPoints());
         startTimer_.start();
     }
 };
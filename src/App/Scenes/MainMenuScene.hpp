@@ -64,6 +64,11 @@ public:
     {
     }
 
+    bool isIdle() const override
+    {
+        return true;
+    }
+
 private:
     MainMenuListener listener_;
 };
@@ -13,6 +13,7 @@
 
 #include <App/HardStrings.hpp>
 #include <SDLWrapper/Audio/AudioDevice.hpp>
+#include <algorithm>
 #include <string>
 #include <unordered_map>
 
@@ -58,7 +59,7 @@ private:
                 scene_.actionRes_ = engine::SceneAction::popAction();
             else if (id == ui::setsMenu::saveThrowB)
             {
-                scene_.appState_.stat().resetAllStatistic();
+                scene_.appState_.resetAllStatistic();
                 scene_.addStatisticToUi();
             }
             else if (auto found = buttons.find(id); found != buttons.end())
@@ -96,6 +97,11 @@ public:
     {
     }
 
+    bool isIdle() const override
+    {
+        return true;
+    }
+
 private:
     SettingsMenuListener listener_;
     app::AppState &appState_;
@@ -161,26 +167,54 @@ private:
         Rml::ElementList recordLabels;
         Rml::ElementList countLabels;
         Rml::ElementList chooseButtons;
+        Rml::ElementList thumbnails;
+        Rml::ElementList metaLabels;
 
         doc->QuerySelectorAll(gameNames, ".game-name");
         doc->QuerySelectorAll(timeLabels, ".time-stat-label");
         doc->QuerySelectorAll(recordLabels, ".record-atat-label");
         doc->QuerySelectorAll(countLabels, ".count-stat-label");
         doc->QuerySelectorAll(chooseButtons, ".choose-b");
+        doc->QuerySelectorAll(thumbnails, ".game-thumb");
+        doc->QuerySelectorAll(metaLabels, ".game-meta");
 
-        IDType index = 0;
+        // Карточек в документе может быть меньше, чем игр
+        const std::size_t cards = std::min({gameNames.size(), timeLabels.size(), recordLabels.size(), countLabels.size(), chooseButtons.size()});
+        std::size_t index = 0;
         for (const auto &gs : appState_.stat().getAll())
         {
-            gameNames[index]->SetInnerRML(gs.name);
+            if (index >= cards)
+                break;
+            const resources::PackInfo *info = appState_.packIndex().find(gs.stringID);
+            gameNames[index]->SetInnerRML(info ? info->name : gs.name);
             timeLabels[index]->SetInnerRML(core::Time::toString(gs.time));
             recordLabels[index]->SetInnerRML(std::to_string(gs.record));
             countLabels[index]->SetInnerRML(std::to_string(gs.gameCount));
             std::string buttonId = gs.stringID + "-choose-b";
             chooseButtons[index]->SetAttribute("id", buttonId);
             chooseButtons_[std::move(buttonId)] = gs.stringID;
+            addPackInfoToUi(info, index < thumbnails.size() ? thumbnails[index] : nullptr, index < metaLabels.size() ? metaLabels[index] : nullptr);
             ++index;
         }
     }
+
+    // Карточка из индекса пакетов: сами пакеты не загружаются
+    void addPackInfoToUi(const resources::PackInfo *info, Rml::Element *thumbnail, Rml::Element *meta)
+    {
+        if (meta)
+            meta->SetInnerRML(info ? "Объектов: " + std::to_string(info->objectCount) + ", уровней: " + std::to_string(info->maxLevel) : "");
+        if (!thumbnail)
+            return;
+        if (!info || info->thumbnailRect.w == 0)
+        {
+            thumbnail->SetProperty("display", "none");
+            return;
+        }
+        const SDL_Rect &r = info->thumbnailRect;
+        thumbnail->SetAttribute("src", "work:" + std::string(names::packThumbnailsFile));
+        thumbnail->SetAttribute("rect", std::to_string(r.x) + ' ' + std::to_string(r.y) + ' ' + std::to_string(r.w) + ' ' + std::to_string(r.h));
+        thumbnail->RemoveProperty("display");
+    }
 };
 
 } // namespace scenes
\ No newline at end of file
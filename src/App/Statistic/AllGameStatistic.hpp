@@ -1,13 +1,23 @@
 #pragma once
 
+#include <cstdint>
+#include <limits>
+#include <string_view>
 #include <vector>
 
 #include <pugixml/pugixml.hpp>
 
+#include <Core/StringHashMap.hpp>
+
 #include "GameStatistic.hpp"
 
 namespace statistic
 {
+
+// Плотный номер игры: индекс в массиве статистики, выдаётся один раз при добавлении
+using GameID = std::uint32_t;
+inline constexpr const GameID noGame = std::numeric_limits<GameID>::max();
+
 struct AllGameStatistic
 {
 public:
@@ -18,26 +28,37 @@ public:
             stat.reset();
     }
 
+    // Единственное место с хэшированием строки (string_view без копии); дальше - по GameID
+    GameID idOf(const std::string_view id) const
+    {
+        auto found = ids_.find(id);
+        return found == ids_.end() ? noGame : found->second;
+    }
+
+    GameStatistic *get(const GameID id)
+    {
+        return id < gameStatistic_.size() ? &gameStatistic_[id] : nullptr;
+    }
+
+    const GameStatistic *get(const GameID id) const
+    {
+        return id < gameStatistic_.size() ? &gameStatistic_[id] : nullptr;
+    }
+
     GameStatistic *findById(const std::string_view id)
     {
-        for (auto &gs : gameStatistic_)
-            if (gs.stringID == id)
-                return &gs;
-        return nullptr;
+        return get(idOf(id));
     }
 
     const GameStatistic *findById(const std::string_view id) const
     {
-        for (const auto &gs : gameStatistic_)
-            if (gs.stringID == id)
-                return &gs;
-        return nullptr;
+        return get(idOf(id));
     }
 
     // Обновляет глобальную статистику результатом одной игры.
-    bool applyGameResult(const std::string_view id, const GameStatistic &result)
+    bool applyGameResult(const GameID id, const GameStatistic &result)
     {
-        GameStatistic *gs = findById(id);
+        GameStatistic *gs = get(id);
         if (!gs)
             return false;
 
@@ -53,6 +74,7 @@ public:
     void clear()
     {
         gameStatistic_.clear();
+        ids_.clear();
     }
 
     bool empty() const
@@ -60,11 +82,21 @@ public:
         return gameStatistic_.empty();
     }
 
-    void addGame(GameStatistic stat)
+    // Игра с уже известным stringID заменяется, номер сохраняется
+    GameID addGame(GameStatistic stat)
     {
+        if (const GameID id = idOf(stat.stringID); id != noGame)
+        {
+            gameStatistic_[id] = std::move(stat);
+            return id;
+        }
+        const auto id = static_cast<GameID>(gameStatistic_.size());
+        ids_.emplace(stat.stringID, id);
         gameStatistic_.push_back(std::move(stat));
+        return id;
     }
 
+    // По порядку GameID
     const std::vector<GameStatistic>& getAll() const
     {
         return gameStatistic_;
@@ -72,5 +104,6 @@ public:
 
 private:
     std::vector<GameStatistic> gameStatistic_;
+    core::StringHashMap<GameID> ids_;
 };
-} // namespace statistic
\ No newline at end of file
+} // namespace statistic
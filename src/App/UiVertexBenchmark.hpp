@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_timer.h>
+
+#include <pugixml/pugixml.hpp>
+
+#include <RmlUi/RmlUi_VertexKernel.h>
+
+#include <App/IO/MappedFile.hpp>
+
+namespace app
+{
+
+// Число глифов в документе RmlUi: непробельные символы текста (UTF-8)
+inline std::size_t countRmlGlyphs(const std::filesystem::path &file)
+{
+    IO::MappedFile text(file);
+    pugi::xml_document doc;
+    if (text.empty() || !doc.load_buffer_inplace(text.mutableData(), text.size()))
+        return 0;
+
+    struct Walker : pugi::xml_tree_walker
+    {
+        std::size_t glyphs = 0;
+        bool for_each(pugi::xml_node &node) override
+        {
+            if (node.type() != pugi::node_pcdata || std::string_view(node.parent().name()) == "style")
+                return true;
+            for (const char *c = node.value(); *c; ++c)
+            {
+                const unsigned char ch = static_cast<unsigned char>(*c);
+                if ((ch & 0xC0) != 0x80 && ch > ' ')
+                    ++glyphs;
+            }
+            return true;
+        }
+    } walker;
+    doc.traverse(walker);
+    return walker.glyphs;
+}
+
+// Замер ядра вершин RmlUi (RmlUi_VertexKernel.h) на квадах глифов документов.
+// Сравнивается старый путь RenderGeometry (new[] + скалярный цикл) со скалярной и SIMD версиями.
+inline void runUiVertexBenchmark(const std::vector<std::filesystem::path> &documents, const unsigned int iterations)
+{
+    std::size_t glyphs = 0;
+    for (const auto &file : documents)
+    {
+        const std::size_t count = countRmlGlyphs(file);
+        SDL_Log("UiBench: %s - %zu glyphs", file.filename().string().c_str(), count);
+        glyphs += count;
+    }
+    if (glyphs == 0)
+    {
+        SDL_Log("UiBench: no glyphs found");
+        return;
+    }
+
+    // Квад на глиф, строки по 40 глифов
+    std::vector<Rml::Vertex> source(glyphs * 4);
+    for (std::size_t i = 0; i < glyphs; ++i)
+    {
+        const float x = static_cast<float>(i % 40) * 12.f;
+        const float y = static_cast<float>(i / 40) * 20.f;
+        const Rml::Vector2f corners[4] = {{x, y}, {x + 10.f, y}, {x + 10.f, y + 18.f}, {x, y + 18.f}};
+        for (int j = 0; j < 4; ++j)
+        {
+            Rml::Vertex &v = source[i * 4 + j];
+            v.position = corners[j];
+            v.tex_coord = {static_cast<float>(j & 1), static_cast<float>(j >> 1)};
+            v.colour = Rml::ColourbPremultiplied(255, 255, 255, static_cast<Rml::byte>(200 + i % 56));
+        }
+    }
+    const std::size_t count = source.size();
+    std::vector<SDL_Vertex> converted(count);
+    std::vector<SDL_Vertex> transformed(count);
+
+    Rml::Matrix4f matrix = Rml::Matrix4f::Identity();
+    matrix[0][0] = 0.98f;
+    matrix[0][1] = 0.17f;
+    matrix[1][0] = -0.17f;
+    matrix[1][1] = 0.98f;
+    const RmlVertexKernel::Affine2D affine = RmlVertexKernel::MakeAffine2D(&matrix, {16.f, 32.f});
+
+    auto measure = [&](const char *name, auto &&body)
+    {
+        const Uint64 start = SDL_GetTicksNS();
+        for (unsigned int i = 0; i < iterations; ++i)
+            body();
+        const Uint64 ns = SDL_GetTicksNS() - start;
+        const double perVertex = static_cast<double>(ns) / iterations / count;
+        SDL_Log("UiBench: %-28s %8.2f us/frame %6.3f ns/vertex", name, ns / 1000.0 / iterations, perVertex);
+        return perVertex;
+    };
+
+    const double legacy = measure("alloc + scalar (old)",
+                                  [&]()
+                                  {
+                                      std::unique_ptr<SDL_Vertex[]> tmp{new SDL_Vertex[count]};
+                                      RmlVertexKernel::ConvertVerticesScalar(source.data(), tmp.get(), count);
+                                      RmlVertexKernel::TransformVerticesScalar(tmp.get(), tmp.get(), count, affine);
+                                      converted[0] = tmp[0];
+                                  });
+    const double convertScalar = measure("convert scalar",
+                                         [&]()
+                                         { RmlVertexKernel::ConvertVerticesScalar(source.data(), converted.data(), count); });
+    const double convertSimd = measure("convert kernel",
+                                       [&]()
+                                       { RmlVertexKernel::ConvertVertices(source.data(), converted.data(), count); });
+    const double transformScalar = measure("transform scalar",
+                                           [&]()
+                                           { RmlVertexKernel::TransformVerticesScalar(converted.data(), transformed.data(), count, affine); });
+    const double transformSimd = measure("transform kernel",
+                                         [&]()
+                                         { RmlVertexKernel::TransformVertices(converted.data(), transformed.data(), count, affine); });
+
+    SDL_Log("UiBench: %s, %zu vertices, %u iterations", RmlVertexKernel::Name(), count, iterations);
+    SDL_Log("UiBench: convert x%.2f, transform x%.2f, kernel vs old path x%.2f",
+            convertScalar / convertSimd, transformScalar / transformSimd, legacy / (convertSimd + transformSimd));
+}
+
+} // namespace app
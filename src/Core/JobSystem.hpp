@@ -0,0 +1,205 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace core
+{
+
+// Число незавершённых задач группы; JobSystem::wait ждёт, пока оно станет 0
+class JobCounter
+{
+public:
+    bool done() const
+    {
+        return count_.load(std::memory_order_acquire) == 0;
+    }
+
+private:
+    friend class JobSystem;
+    std::atomic<std::size_t> count_ = 0;
+};
+
+// Пул потоков с кражей задач: у каждого потока своя очередь, свои задачи он берёт с конца,
+// чужие - крадёт с начала. Поток, ждущий группу (wait), сам выполняет задачи, поэтому
+// вложенные группы не блокируют пул.
+class JobSystem
+{
+public:
+    using Job = std::function<void()>;
+
+public:
+    static JobSystem &instance()
+    {
+        static JobSystem jobs(defaultThreadCount());
+        return jobs;
+    }
+
+    // Главный поток тоже работает в wait(), поэтому ядер - 1
+    static unsigned int defaultThreadCount()
+    {
+        const unsigned int cores = std::thread::hardware_concurrency();
+        return cores > 1 ? cores - 1 : 1;
+    }
+
+    explicit JobSystem(const unsigned int threads)
+    {
+        const unsigned int count = std::max(1u, threads);
+        for (unsigned int i = 0; i < count; ++i)
+            queues_.push_back(std::make_unique<Queue>());
+        for (unsigned int i = 0; i < count; ++i)
+            threads_.emplace_back([this, i]() { workerLoop(i); });
+    }
+    JobSystem(const JobSystem &) = delete;
+    JobSystem &operator=(const JobSystem &) = delete;
+    ~JobSystem()
+    {
+        {
+            std::lock_guard lock(sleepMutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (std::thread &thread : threads_)
+            thread.join();
+    }
+
+    unsigned int threadCount() const
+    {
+        return static_cast<unsigned int>(threads_.size());
+    }
+
+    void submit(JobCounter &counter, Job job)
+    {
+        counter.count_.fetch_add(1, std::memory_order_relaxed);
+        // Из рабочего потока - в свою очередь (горячие данные), снаружи - по кругу
+        const std::size_t ind = currentOwner_ == this ? currentIndex_ : next_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+        {
+            std::lock_guard lock(queues_[ind]->mutex);
+            queues_[ind]->tasks.push_back({std::move(job), &counter});
+        }
+        {
+            std::lock_guard lock(sleepMutex_);
+            ++pending_;
+        }
+        wake_.notify_one();
+    }
+
+    // Выполняет задачи пула, пока группа не завершится
+    void wait(const JobCounter &counter)
+    {
+        const std::size_t home = currentOwner_ == this ? currentIndex_ : 0;
+        while (!counter.done())
+        {
+            Task task;
+            if (take(home, task))
+                run(task);
+            else
+                std::this_thread::yield();
+        }
+    }
+
+    // f(i) для i из [0, count), возврат после завершения всех
+    template <typename F>
+    void parallelFor(const std::size_t count, F &&f)
+    {
+        JobCounter counter;
+        for (std::size_t i = 0; i < count; ++i)
+            submit(counter, [&f, i]() { f(i); });
+        wait(counter);
+    }
+
+private:
+    struct Task
+    {
+        Job job;
+        JobCounter *counter = nullptr;
+    };
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> threads_;
+    std::atomic<std::size_t> next_ = 0;
+
+    std::mutex sleepMutex_;
+    std::condition_variable wake_;
+    std::size_t pending_ = 0; // под sleepMutex_
+    bool stop_ = false;       // под sleepMutex_
+
+    inline static thread_local const JobSystem *currentOwner_ = nullptr;
+    inline static thread_local std::size_t currentIndex_ = 0;
+
+private:
+    void workerLoop(const std::size_t ind)
+    {
+        currentOwner_ = this;
+        currentIndex_ = ind;
+        while (true)
+        {
+            Task task;
+            if (take(ind, task))
+            {
+                run(task);
+                continue;
+            }
+            std::unique_lock lock(sleepMutex_);
+            wake_.wait(lock, [this]() { return stop_ || pending_ > 0; });
+            if (stop_ && pending_ == 0)
+                return;
+        }
+    }
+
+    // Своя очередь с конца, затем кража у остальных с начала
+    bool take(const std::size_t home, Task &out)
+    {
+        {
+            Queue &own = *queues_[home];
+            std::lock_guard lock(own.mutex);
+            if (!own.tasks.empty())
+            {
+                out = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                return taken();
+            }
+        }
+        for (std::size_t i = 1; i < queues_.size(); ++i)
+        {
+            Queue &victim = *queues_[(home + i) % queues_.size()];
+            std::lock_guard lock(victim.mutex);
+            if (!victim.tasks.empty())
+            {
+                out = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                return taken();
+            }
+        }
+        return false;
+    }
+
+    bool taken()
+    {
+        std::lock_guard lock(sleepMutex_);
+        --pending_;
+        return true;
+    }
+
+    static void run(Task &task)
+    {
+        task.job();
+        task.counter->count_.fetch_sub(1, std::memory_order_acq_rel);
+    }
+};
+
+} // namespace core
@@ -5,54 +5,121 @@
 
 #include <filesystem>
 #include <string>
-#include <unordered_map>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
 
+#include <SDL3/SDL_filesystem.h>
 #include <SDLWrapper/Audio/AudioDevice.hpp>
 
+#include "ResourceHandle.hpp"
+
 namespace core::managers
 {
 
 class AudioManager
 {
+public:
+    // sdl3::audio::Audio не сообщает размер буфера, поэтому объём декодированного звука оценивается
+    // по файлу: MP3 128 кбит/с -> PCM 16 бит стерео 44.1 кГц примерно в 11 раз больше
+    inline static constexpr const std::size_t decodedPerEncoded = 11;
+
 public:
     AudioManager() = default;
 
+    static std::size_t estimateBytes(const std::filesystem::path &filePath)
+    {
+        SDL_PathInfo info{};
+        if (!SDL_GetPathInfo(filePath.string().c_str(), &info))
+            return 0;
+        return static_cast<std::size_t>(info.size) * decodedPerEncoded;
+    }
+
     bool load(const std::string &key, const std::filesystem::path &filePath)
     {
+        const AudioHandle h = registry_.handle(key);
         bool res = false;
-        res = audios_[key].loadFromFile(filePath.string().c_str());
+        res = registry_.slot(h).loadFromFile(filePath.string().c_str());
 
         if (!res)
         {
-            unload(key);
+            registry_.reset(h);
             return false;
         }
+        registry_.setBytes(h, estimateBytes(filePath));
         return true;
     }
 
-    const sdl3::audio::Audio *get(const std::string &key) const
+    // Уже декодированный звук (например, в фоновом потоке)
+    void add(const std::string &key, sdl3::audio::Audio &&audio, const std::size_t bytes = 0)
+    {
+        const AudioHandle h = registry_.handle(key);
+        registry_.slot(h) = std::move(audio);
+        registry_.setBytes(h, bytes);
+    }
+
+    // Номер ключа для хранения в определениях; звук может быть загружен позже
+    AudioHandle handle(const std::string_view key)
+    {
+        return registry_.handle(key);
+    }
+
+    const sdl3::audio::Audio *get(const AudioHandle handle) const
+    {
+        return registry_.get(handle);
+    }
+
+    const sdl3::audio::Audio *get(const std::string_view key) const
     {
-        auto it = audios_.find(key);
-        return it == audios_.end() ? nullptr : &it->second;
+        return registry_.get(registry_.find(key));
     }
 
-    bool has(const std::string &key) const
+    bool has(const std::string_view key) const
     {
         return get(key) != nullptr;
     }
 
-    void unload(const std::string &key)
+    // Ключи загруженных звуков
+    std::unordered_set<std::string> keys() const
+    {
+        std::unordered_set<std::string> res;
+        for (std::uint32_t i = 0; i < registry_.size(); ++i)
+            if (registry_.get(AudioHandle{i}))
+                res.insert(registry_.keyOf(AudioHandle{i}));
+        return res;
+    }
+
+    // Ссылки пакетов (ResourceRegistry): без ссылок звук может быть выгружен по бюджету
+    bool acquire(const std::string_view key)
+    {
+        return registry_.acquire(registry_.handle(key));
+    }
+    void release(const std::string_view key)
+    {
+        registry_.release(registry_.find(key));
+    }
+
+    void setBudget(const std::size_t bytes)
+    {
+        registry_.setBudget(bytes);
+    }
+    const CacheStats &stats() const
+    {
+        return registry_.stats();
+    }
+
+    void unload(const std::string_view key)
     {
-        audios_.erase(key);
+        registry_.reset(registry_.find(key));
     }
 
     void clear()
     {
-        audios_.clear();
+        registry_.clear();
     }
 
 private:
-    std::unordered_map<std::string, sdl3::audio::Audio> audios_;
+    ResourceRegistry<sdl3::audio::Audio, AudioHandle> registry_;
 };
 
 } // namespace core::managers
@@ -0,0 +1,200 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <Core/StringHashMap.hpp>
+
+namespace core::managers
+{
+
+// Номер ресурса в менеджере. Выдаётся один раз на ключ и не меняется при выгрузке/перезагрузке,
+// поэтому его можно хранить в определениях объектов и получать ресурс без строк и хэширования.
+template <typename Tag>
+struct ResourceHandle
+{
+    inline static constexpr const std::uint32_t invalid = std::numeric_limits<std::uint32_t>::max();
+
+    std::uint32_t index = invalid;
+
+    bool valid() const
+    {
+        return index != invalid;
+    }
+
+    bool operator==(const ResourceHandle &) const = default;
+};
+
+using TextureHandle = ResourceHandle<struct TextureTag>;
+using AudioHandle = ResourceHandle<struct AudioTag>;
+
+struct CacheStats
+{
+    std::uint64_t hits = 0;      // пакету ресурс достался уже загруженным
+    std::uint64_t misses = 0;    // пришлось загрузить
+    std::uint64_t evictions = 0; // выгружено по бюджету
+    std::size_t bytes = 0;       // сейчас в памяти
+    std::size_t budget = 0;
+};
+
+// Ключи, интернированные в плотные номера, и ресурсы по номерам.
+// Ресурс лежит в unique_ptr - указатель на него не меняется при росте массива.
+// Пакеты держат ресурсы ссылками (acquire/release). Ресурс без ссылок остаётся в памяти,
+// пока общий объём не превысит бюджет; тогда выгружаются давно отпущенные (LRU).
+template <typename T, typename Handle>
+class ResourceRegistry
+{
+public:
+    inline static constexpr const std::size_t unlimited = std::numeric_limits<std::size_t>::max();
+
+public:
+    // Интернирует ключ; ресурса под ним может ещё не быть
+    Handle handle(const std::string_view key)
+    {
+        if (auto found = ids_.find(key); found != ids_.end())
+            return {found->second};
+        const auto index = static_cast<std::uint32_t>(slots_.size());
+        ids_.emplace(std::string(key), index);
+        keys_.emplace_back(key);
+        slots_.emplace_back();
+        return {index};
+    }
+
+    // Без интернирования: invalid, если ключ не встречался
+    Handle find(const std::string_view key) const
+    {
+        auto found = ids_.find(key);
+        return found == ids_.end() ? Handle{} : Handle{found->second};
+    }
+
+    T *get(const Handle handle)
+    {
+        return handle.index < slots_.size() ? slots_[handle.index].res.get() : nullptr;
+    }
+    const T *get(const Handle handle) const
+    {
+        return handle.index < slots_.size() ? slots_[handle.index].res.get() : nullptr;
+    }
+
+    // Объект под номером; создаётся при первом обращении, дальше переиспользуется (адрес не меняется)
+    T &slot(const Handle handle)
+    {
+        Slot &s = slots_[handle.index];
+        if (!s.res)
+            s.res = std::make_unique<T>();
+        s.lastUse = ++clock_;
+        return *s.res;
+    }
+
+    // После загрузки в slot(): размер для бюджета
+    void setBytes(const Handle handle, const std::size_t bytes)
+    {
+        Slot &s = slots_[handle.index];
+        stats_.bytes = stats_.bytes - s.bytes + bytes;
+        s.bytes = bytes;
+        trim();
+    }
+
+    void reset(const Handle handle)
+    {
+        if (handle.index >= slots_.size())
+            return;
+        Slot &s = slots_[handle.index];
+        s.res.reset();
+        stats_.bytes -= s.bytes;
+        s.bytes = 0;
+    }
+
+    // Ссылка пакета; true - ресурс уже в памяти (попадание)
+    bool acquire(const Handle handle)
+    {
+        Slot &s = slots_[handle.index];
+        ++s.refs;
+        s.lastUse = ++clock_;
+        const bool hit = s.res != nullptr;
+        ++(hit ? stats_.hits : stats_.misses);
+        return hit;
+    }
+
+    // Сразу не выгружает: отпущенный звук может ещё доигрывать. Выгрузка - при следующей загрузке (setBytes)
+    void release(const Handle handle)
+    {
+        if (handle.index >= slots_.size() || slots_[handle.index].refs == 0)
+            return;
+        Slot &s = slots_[handle.index];
+        --s.refs;
+        s.lastUse = ++clock_;
+    }
+
+    void setBudget(const std::size_t bytes)
+    {
+        stats_.budget = bytes;
+        trim();
+    }
+
+    // Выгружает ресурсы без ссылок, начиная с давно отпущенных, пока объём больше бюджета
+    void trim()
+    {
+        while (stats_.bytes > stats_.budget)
+        {
+            Slot *oldest = nullptr;
+            for (Slot &s : slots_)
+                if (s.res && s.refs == 0 && (!oldest || s.lastUse < oldest->lastUse))
+                    oldest = &s;
+            if (!oldest)
+                return;
+            oldest->res.reset();
+            stats_.bytes -= oldest->bytes;
+            oldest->bytes = 0;
+            ++stats_.evictions;
+        }
+    }
+
+    // Ресурсы освобождаются, номера остаются действительными
+    void clear()
+    {
+        for (Slot &s : slots_)
+        {
+            s.res.reset();
+            s.bytes = 0;
+        }
+        stats_.bytes = 0;
+    }
+
+    std::size_t size() const
+    {
+        return slots_.size();
+    }
+
+    const std::string &keyOf(const Handle handle) const
+    {
+        return keys_[handle.index];
+    }
+
+    const CacheStats &stats() const
+    {
+        return stats_;
+    }
+
+private:
+    struct Slot
+    {
+        std::unique_ptr<T> res;
+        std::size_t bytes = 0;
+        std::uint32_t refs = 0;
+        std::uint64_t lastUse = 0;
+    };
+
+    core::StringHashMap<std::uint32_t> ids_;
+    std::vector<std::string> keys_;
+    std::vector<Slot> slots_;
+    std::uint64_t clock_ = 0;
+    CacheStats stats_{0, 0, 0, 0, unlimited};
+};
+
+} // namespace core::managers
@@ -4,8 +4,13 @@
 #include <SDLWrapper/Texture.hpp>
 
 #include <filesystem>
+#include <memory>
 #include <string>
-#include <unordered_map>
+#include <string_view>
+
+#include <SDL3/SDL_render.h>
+
+#include "ResourceHandle.hpp"
 
 namespace core::managers
 {
@@ -17,39 +22,79 @@ public:
 
     bool load(const std::string& key, const std::filesystem::path &filePath)
     {
-        bool res = textures_[key].loadFromFile(filePath.string().c_str());
+        const TextureHandle h = registry_.handle(key);
+        sdl3::Texture &texture = registry_.slot(h);
+        bool res = texture.loadFromFile(filePath.string().c_str());
         if(!res)
         {
-            unload(key);
+            registry_.reset(h);
             return false;
         }
+        registry_.setBytes(h, bytesOf(texture));
         return true;
     }
 
-    const sdl3::Texture *get(const std::string& key) const
+    // Номер ключа для хранения в определениях; текстура может быть загружена позже
+    TextureHandle handle(const std::string_view key)
+    {
+        return registry_.handle(key);
+    }
+
+    const sdl3::Texture *get(const TextureHandle handle) const
+    {
+        return registry_.get(handle);
+    }
+
+    const sdl3::Texture *get(const std::string_view key) const
     {
-        auto it = textures_.find(key);
-        return it == textures_.end() ? nullptr : &it->second;
+        return registry_.get(registry_.find(key));
     }
 
-    bool has(const std::string& key) const
+    bool has(const std::string_view key) const
     {
         return get(key) != nullptr;
     }
 
-    void unload(const std::string& key)
+    // Ссылки пакетов (ResourceRegistry): без ссылок текстура может быть выгружена по бюджету
+    bool acquire(const std::string_view key)
+    {
+        return registry_.acquire(registry_.handle(key));
+    }
+    void release(const std::string_view key)
     {
-        textures_.erase(key);
+        registry_.release(registry_.find(key));
+    }
+
+    void setBudget(const std::size_t bytes)
+    {
+        registry_.setBudget(bytes);
+    }
+    const CacheStats &stats() const
+    {
+        return registry_.stats();
+    }
+
+    void unload(const std::string_view key)
+    {
+        registry_.reset(registry_.find(key));
     }
 
     void clear()
     {
-        textures_.clear();
+        registry_.clear();
     }
 
 private:
-    std::unordered_map<std::string, sdl3::Texture> textures_;
+    ResourceRegistry<sdl3::Texture, TextureHandle> registry_;
+
+private:
+    static std::size_t bytesOf(const sdl3::Texture &texture)
+    {
+        float w = 0.f, h = 0.f;
+        if (!SDL_GetTextureSize(std::to_address(texture.getNativeSDLTexture()), &w, &h))
+            return 0;
+        return static_cast<std::size_t>(w) * static_cast<std::size_t>(h) * 4;
+    }
 };
 
 } // namespace app
-
@@ -0,0 +1,333 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <ctime>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_timer.h>
+#include <SDLWrapper/FileWorker.hpp>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+namespace core
+{
+
+// Процессорное время процесса (все потоки, user + kernel) в наносекундах.
+// Не std::clock(): в MSVC он считает реальное время, и простой не отличить от отрисовки.
+inline Uint64 processCpuNS()
+{
+#if defined(_WIN32)
+    FILETIME creation, exit, kernel, user;
+    if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user))
+        return 0;
+    auto ns = [](const FILETIME &t) { return ((static_cast<Uint64>(t.dwHighDateTime) << 32) | t.dwLowDateTime) * 100; };
+    return ns(kernel) + ns(user);
+#elif defined(CLOCK_PROCESS_CPUTIME_ID)
+    timespec ts{};
+    if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts) != 0)
+        return 0;
+    return static_cast<Uint64>(ts.tv_sec) * SDL_NS_PER_SECOND + static_cast<Uint64>(ts.tv_nsec);
+#else
+    return static_cast<Uint64>(std::clock()) * SDL_NS_PER_SECOND / CLOCKS_PER_SEC;
+#endif
+}
+
+enum class ProfileZone : unsigned char
+{
+    Frame,
+    SceneUpdate,
+    Physics,
+    Merges,
+    RmlUpdate,
+    SceneDraw,
+    RmlRender,
+    Present,
+    Delay,
+    Count
+};
+
+inline constexpr const std::size_t profileZoneCount = static_cast<std::size_t>(ProfileZone::Count);
+
+inline constexpr const char *profileZoneName(const ProfileZone zone)
+{
+    constexpr const char *names[profileZoneCount] = {"frame", "update", "physics", "merges", "rml update", "draw", "rml render", "present", "delay"};
+    return names[static_cast<std::size_t>(zone)];
+}
+
+// Времена зон одного кадра (нс). Если зона вызывалась несколько раз, длительности суммируются.
+struct ProfileFrame
+{
+    Uint64 startNS = 0;
+    std::array<Uint64, profileZoneCount> zoneStartNS{};
+    std::array<Uint64, profileZoneCount> durationNS{};
+};
+
+// Гистограмма интервалов между началами кадров: корзины по bucketUS, последняя - всё длиннее
+struct FrameTimeHistogram
+{
+    inline static constexpr const std::size_t bucketUS = 500;
+    inline static constexpr const std::size_t bucketCount = 80;
+
+    std::array<std::uint32_t, bucketCount> buckets{};
+    std::uint64_t total = 0;
+
+    void add(const Uint64 intervalNS)
+    {
+        const std::size_t ind = std::min<std::size_t>(static_cast<std::size_t>(intervalNS / 1000 / bucketUS), bucketCount - 1);
+        ++buckets[ind];
+        ++total;
+    }
+    void clear()
+    {
+        buckets.fill(0);
+        total = 0;
+    }
+};
+
+// Профайлер кадров: последние capacity кадров в кольцевом буфере.
+// Пишет один поток (главный), номер кадра публикуется атомарно, поэтому чтение не блокирует запись.
+class Profiler
+{
+public:
+    inline static constexpr const std::size_t capacity = 512;
+
+public:
+    static Profiler &instance()
+    {
+        static Profiler profiler;
+        return profiler;
+    }
+
+    void setEnabled(const bool enabled)
+    {
+        enabled_ = enabled;
+    }
+    bool isEnabled() const
+    {
+        return enabled_;
+    }
+
+    void beginFrame()
+    {
+        const Uint64 now = SDL_GetTicksNS();
+        if (enabled_ && current_.startNS != 0)
+            histogram_.add(now - current_.startNS);
+        current_ = {};
+        current_.startNS = now;
+    }
+
+    void endFrame()
+    {
+        if (!enabled_ || current_.startNS == 0)
+            return;
+        const std::size_t frame = static_cast<std::size_t>(ProfileZone::Frame);
+        current_.zoneStartNS[frame] = current_.startNS;
+        current_.durationNS[frame] = SDL_GetTicksNS() - current_.startNS;
+
+        const std::uint64_t head = head_.load(std::memory_order_relaxed);
+        frames_[head % capacity] = current_;
+        head_.store(head + 1, std::memory_order_release);
+    }
+
+    void add(const ProfileZone zone, const Uint64 startNS, const Uint64 durationNS)
+    {
+        const std::size_t ind = static_cast<std::size_t>(zone);
+        if (current_.zoneStartNS[ind] == 0)
+            current_.zoneStartNS[ind] = startNS;
+        current_.durationNS[ind] += durationNS;
+    }
+
+    // Процессорное время процесса за секунду (processCpuNS()), отдельно для режима простоя и постоянной отрисовки.
+    // Окно - cpuWindowNS реального времени.
+    void sampleCpu(const bool idle)
+    {
+        const Uint64 now = SDL_GetTicksNS();
+        const Uint64 cpu = processCpuNS();
+        if (cpuWindowStartNS_ == 0 || idle != cpuWindowIdle_)
+        {
+            cpuWindowStartNS_ = now;
+            cpuWindowStart_ = cpu;
+            cpuWindowIdle_ = idle;
+            return;
+        }
+        if (now - cpuWindowStartNS_ < cpuWindowNS)
+            return;
+        const float cpuMS = static_cast<float>(cpu - cpuWindowStart_) / SDL_NS_PER_MS;
+        const float wallS = static_cast<float>(now - cpuWindowStartNS_) / SDL_NS_PER_SECOND;
+        (idle ? cpuIdleMSPerS_ : cpuActiveMSPerS_) = cpuMS / wallS;
+#ifdef DEBUG_BUILD_TYPE
+        SDL_Log("Profiler: cpu %.1f ms/s (%s)", cpuMS / wallS, idle ? "idle" : "continuous");
+#endif
+        cpuWindowStartNS_ = now;
+        cpuWindowStart_ = cpu;
+    }
+
+    // GET METHODS
+
+    // Последний замер процессорного времени (мс за секунду), 0 - ещё не было
+    float getCpuMSPerSecond(const bool idle) const
+    {
+        return idle ? cpuIdleMSPerS_ : cpuActiveMSPerS_;
+    }
+
+    const FrameTimeHistogram &getHistogram() const
+    {
+        return histogram_;
+    }
+    void resetHistogram()
+    {
+        histogram_.clear();
+    }
+
+    std::size_t frameCount() const
+    {
+        return static_cast<std::size_t>(std::min<std::uint64_t>(head_.load(std::memory_order_acquire), capacity));
+    }
+
+    // Кадры от старого к новому
+    std::vector<ProfileFrame> snapshot() const
+    {
+        const std::uint64_t head = head_.load(std::memory_order_acquire);
+        const std::uint64_t count = std::min<std::uint64_t>(head, capacity);
+        std::vector<ProfileFrame> res;
+        res.reserve(count);
+        for (std::uint64_t i = head - count; i < head; ++i)
+            res.push_back(frames_[i % capacity]);
+        return res;
+    }
+
+    // Перцентиль длительности зоны (мс), p от 0 до 1
+    static float percentileMS(const std::vector<ProfileFrame> &frames, const ProfileZone zone, const float p)
+    {
+        if (frames.empty())
+            return 0.f;
+        std::vector<Uint64> values;
+        values.reserve(frames.size());
+        for (const ProfileFrame &frame : frames)
+            values.push_back(frame.durationNS[static_cast<std::size_t>(zone)]);
+        const std::size_t ind = std::min(values.size() - 1, static_cast<std::size_t>(p * values.size()));
+        std::nth_element(values.begin(), values.begin() + ind, values.end());
+        return values[ind] / 1'000'000.f;
+    }
+
+    // Кадр на строку, длительности зон в микросекундах
+    bool dumpCSV(const std::filesystem::path &path) const
+    {
+        std::string out = "frame_start_us";
+        for (std::size_t z = 0; z < profileZoneCount; ++z)
+            out += std::string(",") + profileZoneName(static_cast<ProfileZone>(z));
+        out += '\n';
+        for (const ProfileFrame &frame : snapshot())
+        {
+            out += std::to_string(frame.startNS / 1000);
+            for (const Uint64 ns : frame.durationNS)
+                out += ',' + std::to_string(ns / 1000.0);
+            out += '\n';
+        }
+        return write(path, out);
+    }
+
+    // Формат Trace Event (chrome://tracing, Perfetto): зона кадра - событие "X"
+    bool dumpChromeTrace(const std::filesystem::path &path) const
+    {
+        std::string out = "{\"traceEvents\":[";
+        bool first = true;
+        for (const ProfileFrame &frame : snapshot())
+            for (std::size_t z = 0; z < profileZoneCount; ++z)
+            {
+                if (frame.zoneStartNS[z] == 0)
+                    continue;
+                if (!first)
+                    out += ',';
+                first = false;
+                out += "{\"name\":\"";
+                out += profileZoneName(static_cast<ProfileZone>(z));
+                out += "\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" + std::to_string(frame.zoneStartNS[z] / 1000.0) +
+                       ",\"dur\":" + std::to_string(frame.durationNS[z] / 1000.0) + '}';
+            }
+        out += "]}";
+        return write(path, out);
+    }
+
+    // Интервал кадра (начало корзины, мс) и число кадров
+    bool dumpHistogramCSV(const std::filesystem::path &path) const
+    {
+        std::string out = "interval_ms,frames\n";
+        for (std::size_t i = 0; i < FrameTimeHistogram::bucketCount; ++i)
+            out += std::to_string(i * FrameTimeHistogram::bucketUS / 1000.0) + ',' + std::to_string(histogram_.buckets[i]) + '\n';
+        return write(path, out);
+    }
+
+private:
+    std::array<ProfileFrame, capacity> frames_{};
+    std::atomic<std::uint64_t> head_ = 0;
+    ProfileFrame current_;
+    FrameTimeHistogram histogram_;
+    bool enabled_ = true;
+
+    inline static constexpr const Uint64 cpuWindowNS = 5 * SDL_NS_PER_SECOND;
+    Uint64 cpuWindowStartNS_ = 0;
+    Uint64 cpuWindowStart_ = 0;
+    bool cpuWindowIdle_ = false;
+    float cpuIdleMSPerS_ = 0.f;
+    float cpuActiveMSPerS_ = 0.f;
+
+private:
+    Profiler() = default;
+
+    static bool write(const std::filesystem::path &path, const std::string &text)
+    {
+        sdl3::FileWorker file;
+        if (!file.open(path, sdl3::FileWorkerMode::write | sdl3::FileWorkerMode::binary) || !file.write(text))
+        {
+            SDL_Log("Profiler: failed to write %s", path.string().c_str());
+            return false;
+        }
+        return true;
+    }
+};
+
+// Время от создания до разрушения попадает в зону текущего кадра
+class ProfileScope
+{
+public:
+    explicit ProfileScope(const ProfileZone zone) : zone_(zone), startNS_(SDL_GetTicksNS())
+    {
+    }
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+    ~ProfileScope()
+    {
+        Profiler::instance().add(zone_, startNS_, SDL_GetTicksNS() - startNS_);
+    }
+
+private:
+    ProfileZone zone_;
+    Uint64 startNS_;
+};
+
+} // namespace core
+
+#ifdef CORE_PROFILER_DISABLED
+#define CORE_PROFILE_ZONE(zone)
+#else
+#define CORE_PROFILE_CONCAT_(a, b) a##b
+#define CORE_PROFILE_CONCAT(a, b) CORE_PROFILE_CONCAT_(a, b)
+// CORE_PROFILE_ZONE(Physics); - замер до конца текущей области видимости
+#define CORE_PROFILE_ZONE(zone) ::core::ProfileScope CORE_PROFILE_CONCAT(profileScope_, __LINE__)(::core::ProfileZone::zone)
+#endif
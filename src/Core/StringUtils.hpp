@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <string_view>
 
@@ -17,4 +18,16 @@ namespace core
         return view.substr(off, count);
     }
 
+    // FNV-1a 64: хэш содержимого файлов (проверка устаревших кэшей)
+    // seed - хэш предыдущих данных, чтобы хэшировать несколько кусков подряд
+    inline std::uint64_t fnv1a(const std::string_view data, std::uint64_t hash = 14695981039346656037ull)
+    {
+        for (const char c : data)
+        {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
 }
\ No newline at end of file
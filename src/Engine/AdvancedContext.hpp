@@ -48,6 +48,8 @@ public:
         rendrInterface_ = std::make_unique<RenderInterface_SDL>(renderer_.get());
         systemInterface_ = std::make_unique<SystemInterface_SDL>();
         fileInterface_ = std::make_unique<FileInterface_SDL>();
+        // Файлы рабочей папки в документах: src="work:..."
+        fileInterface_->SetAlias("work:", core::managers::PathManager::workFolder());
 
         rendrInterface_->SetTransformsEnabled(true);
 
@@ -181,6 +183,17 @@ public:
         return context_;
     }
 
+    SDL_Renderer *getRenderer() const
+    {
+        return renderer_.get();
+    }
+
+    // Через сколько секунд RmlUi нужен следующий update (0 - идёт анимация)
+    double getNextUpdateDelay() const
+    {
+        return context_ ? context_->GetNextUpdateDelay() : 0.0;
+    }
+
 private:
     std::unique_ptr<RenderInterface_SDL> rendrInterface_;
     std::unique_ptr<SystemInterface_SDL> systemInterface_;
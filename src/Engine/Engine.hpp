@@ -7,6 +7,7 @@
 #include <SDLWrapper/Names.hpp>
 #include <SDLWrapper/Renders/VideoMode.hpp>
 #include <SDLWrapper/Renders/View.hpp>
+#include <algorithm>
 #include <string_view>
 #include <vector>
 
@@ -17,9 +18,12 @@
 #include <SDLWrapper/SDLWrapper.hpp>
 
 #include "AdvancedContext.hpp"
+#include "Core/Profiler.hpp"
 #include "Core/Types.hpp"
 #include "Engine/EngineSettings.hpp"
 #include "EngineSettings.hpp"
+#include "FramePacer.hpp"
+#include "ProfilerOverlay.hpp"
 #include "Scene.hpp"
 #include "SceneAction.hpp"
 #include "SceneFabrick.hpp"
@@ -31,6 +35,12 @@ namespace engine
 class Engine
 {
 public:
+    // Деструкторы сцен ещё пишут статистику и отпускают ресурсы - до остановки хранилищ и renderer
+    void closeScenes()
+    {
+        scenes_.clear();
+    }
+
     void close()
     {
         scenes_.clear();
@@ -67,8 +77,11 @@ public:
         autoOrientationEnabled_ = setts.autoOrientationEnabled;
 
         registrateSceneFabrick(std::move(setts.scenesFabrick));
+        setVSync(setts.vsync);
+        idleThrottling_ = setts.idleThrottling;
         setFps(setts.fps);
         pushScene(setts.startSceneID);
+        profilerOverlay_.setVisible(context_, setts.profilerOverlay);
 
         return SDL_APP_CONTINUE;
     }
@@ -85,8 +98,22 @@ public:
     void setFps(const unsigned int fps)
     {
         fps_ = fps;
-        if (fps_ > 0)
-            desiredFrameMS_ = 1000.f / static_cast<float>(fps_);
+        pacer_.setFps(fps_);
+    }
+    // true - кадр ждёт present с vsync, false - FramePacer спит до дедлайна кадра
+    void setVSync(const bool enabled)
+    {
+        if (!SDL_SetRenderVSync(window_.getNativeSDLRenderer().get(), enabled ? 1 : SDL_RENDERER_VSYNC_DISABLED))
+        {
+            SDL_Log("%s", SDL_GetError());
+            if (enabled)
+                return;
+        }
+        pacer_.setMode(enabled ? FramePacingMode::VSync : FramePacingMode::Sleep);
+    }
+    void setIdleThrottling(const bool enabled)
+    {
+        idleThrottling_ = enabled;
     }
     void setAutoOrientationEnabled(const bool enabled)
     {
@@ -105,6 +132,8 @@ public:
             return SDL_APP_SUCCESS;
         if (autoOrientationEnabled_ && event.type == SDL_EVENT_WINDOW_RESIZED)
             handleWindowResize(event.window.data1, event.window.data2);
+        if (event.type == SDL_EVENT_KEY_DOWN && handleProfilerKey(event.key.key))
+            return SDL_APP_CONTINUE;
         if (scenes_.empty())
             return SDL_APP_FAILURE;
         window_.convertEventToRenderCoordinates(&event);
@@ -118,16 +147,34 @@ public:
     {
         if (scenes_.empty())
             return SDL_APP_FAILURE;
+        core::Profiler &profiler = core::Profiler::instance();
+        profiler.beginFrame();
         const float dt = cl_.elapsedTimeS();
         cl_.start();
-        SceneAction act = scenes_.back()->update(dt);
+        SceneAction act;
+        {
+            CORE_PROFILE_ZONE(SceneUpdate);
+            act = scenes_.back()->update(dt);
+        }
         SDL_AppResult res = processSceneAction(act);
         if (res != SDL_APP_CONTINUE)
             return res;
-        context_.update();
+        profilerOverlay_.update();
+        {
+            CORE_PROFILE_ZONE(RmlUpdate);
+            context_.update();
+        }
         audio_.update();
         safeDrawScene();
-        fpsDelay();
+        {
+            CORE_PROFILE_ZONE(Delay);
+            pacer_.wait();
+        }
+        profiler.endFrame();
+        profiler.sampleCpu(idle_);
+        idle_ = idleThrottling_ && !scenes_.empty() && scenes_.back()->isIdle();
+        if (idle_)
+            waitIdle();
         return res;
     }
 
@@ -147,9 +194,13 @@ private:
     std::vector<ScenePtr> scenes_;
     SceneFabrickPtr sceneFabrick_;
 
-    // желаемое время кадра (мс)
-    float desiredFrameMS_{};
     unsigned int fps_{};
+    FramePacer pacer_;
+
+    // Ожидание в режиме простоя не дольше (чтобы audio_.update() всё же вызывался)
+    inline static constexpr const Sint32 maxIdleWaitMS = 500;
+    bool idleThrottling_ = true;
+    bool idle_ = false;
 
 private:
     sdl3::audio::AudioDevice audio_;
@@ -157,6 +208,8 @@ private:
     Context context_;
     sdl3::ClockNS cl_;
 
+    ProfilerOverlay profilerOverlay_;
+
     WindowSizeInfo winSizeInfo_;
     SDL_RendererLogicalPresentation mode_;
     bool autoOrientationEnabled_ = true;
@@ -176,21 +229,45 @@ private:
     void safeDrawScene()
     {
         window_.clear(sdl3::Colors::White);
-        scenes_.back()->draw(window_);
-        context_.render();
+        {
+            CORE_PROFILE_ZONE(SceneDraw);
+            scenes_.back()->draw(window_);
+        }
+        {
+            CORE_PROFILE_ZONE(RmlRender);
+            context_.render();
+        }
+        CORE_PROFILE_ZONE(Present);
         window_.display();
     }
 
-    void fpsDelay()
+    // Ждём событие или анимацию RmlUi. События SDL передаст в updateEvents до следующего iterate.
+    void waitIdle()
     {
-        if (fps_ == 0)
+        const double delayS = context_.getNextUpdateDelay();
+        if (delayS <= 0.0)
             return;
+        const double waitMS = std::min(delayS * 1000.0, static_cast<double>(maxIdleWaitMS));
+        SDL_WaitEventTimeout(nullptr, static_cast<Sint32>(waitMS));
+    }
 
-        // фактическое время, затраченное на кадр (мс)
-        float frameMS = cl_.elapsedTimeMS();
-
-        if (frameMS < desiredFrameMS_)
-            SDL_Delay(static_cast<Uint32>(desiredFrameMS_ - frameMS));
+    // F3 - таблица профайлера, F4 - сохранить кольцо кадров (CSV, Chrome trace) и гистограмму интервалов
+    bool handleProfilerKey(const SDL_Keycode key)
+    {
+        if (key == SDLK_F3)
+        {
+            profilerOverlay_.toggle(context_);
+            return true;
+        }
+        if (key == SDLK_F4)
+        {
+            const core::Profiler &profiler = core::Profiler::instance();
+            profiler.dumpCSV(core::managers::PathManager::workFolder() / "profile.csv");
+            profiler.dumpChromeTrace(core::managers::PathManager::workFolder() / "profile.json");
+            profiler.dumpHistogramCSV(core::managers::PathManager::workFolder() / "profile-frames.csv");
+            return true;
+        }
+        return false;
     }
 
 private: // SceneActionType process
@@ -25,8 +25,15 @@ struct EngineSettings
     SDL_RendererLogicalPresentation mode = SDL_RendererLogicalPresentation::SDL_LOGICAL_PRESENTATION_DISABLED;
 
     unsigned int fps = 0;
+    // Ожидание кадра через vsync вместо сна FramePacer
+    bool vsync = false;
+    // Сцены с Scene::isIdle() перерисовываются только по событиям и анимациям RmlUi
+    bool idleThrottling = true;
     IDType startSceneID = 0;
 
+    // Таблица core::Profiler при старте (переключается F3)
+    bool profilerOverlay = false;
+
 };
 
 } // namespace engine
\ No newline at end of file
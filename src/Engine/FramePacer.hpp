@@ -0,0 +1,74 @@
+#pragma once
+
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_timer.h>
+
+namespace engine
+{
+
+enum class FramePacingMode : unsigned char
+{
+    Off,   // без ожидания
+    Sleep, // сон до дедлайна кадра
+    VSync  // ожидание делает present (SDL_SetRenderVSync)
+};
+
+// Выдерживает период кадра по абсолютным дедлайнам: ошибка сна одного кадра
+// не копится, а вычитается из следующего.
+class FramePacer
+{
+public:
+    // Последний участок ожидания крутится в цикле - сон ОС может проспать
+    inline static constexpr const Uint64 spinNS = 1'000'000;
+
+public:
+    void setFps(const unsigned int fps)
+    {
+        periodNS_ = fps > 0 ? SDL_NS_PER_SECOND / fps : 0;
+        deadlineNS_ = 0;
+    }
+    void setMode(const FramePacingMode mode)
+    {
+        mode_ = mode;
+        deadlineNS_ = 0;
+    }
+    FramePacingMode getMode() const
+    {
+        return mode_;
+    }
+
+    // Вызывается в конце кадра
+    void wait()
+    {
+        if (periodNS_ == 0 || mode_ != FramePacingMode::Sleep)
+            return;
+
+        const Uint64 now = SDL_GetTicksNS();
+        if (deadlineNS_ == 0)
+            deadlineNS_ = now;
+        deadlineNS_ += periodNS_;
+
+        // Отстали больше чем на кадр (загрузка, сворачивание) - не догоняем
+        if (now > deadlineNS_ + periodNS_)
+        {
+            deadlineNS_ = now;
+            return;
+        }
+        if (now >= deadlineNS_)
+            return;
+
+        const Uint64 left = deadlineNS_ - now;
+        if (left > spinNS)
+            SDL_DelayPrecise(left - spinNS);
+        while (SDL_GetTicksNS() < deadlineNS_)
+        {
+        }
+    }
+
+private:
+    FramePacingMode mode_ = FramePacingMode::Sleep;
+    Uint64 periodNS_ = 0;
+    Uint64 deadlineNS_ = 0;
+};
+
+} // namespace engine
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstdio>
+#include <string>
+
+#include <RmlUi/Core/Context.h>
+#include <RmlUi/Core/Element.h>
+#include <RmlUi/Core/ElementDocument.h>
+
+#include <Core/Profiler.hpp>
+
+#include "AdvancedContext.hpp"
+
+namespace engine
+{
+
+// Таблица p50/p95/p99 зон core::Profiler поверх текущей сцены
+class ProfilerOverlay
+{
+public:
+    // Текст обновляется не чаще раза в refreshNS (в простое кадров мало)
+    inline static constexpr const Uint64 refreshNS = 500'000'000;
+
+public:
+    void setVisible(Context &context, const bool visible)
+    {
+        if (visible && !doc_)
+            load(context);
+        if (!doc_)
+            return;
+        visible_ = visible;
+        if (visible_)
+            doc_->Show();
+        else
+            doc_->Hide();
+    }
+
+    void toggle(Context &context)
+    {
+        setVisible(context, !visible_);
+    }
+
+    bool isVisible() const
+    {
+        return visible_;
+    }
+
+    void update()
+    {
+        const Uint64 now = SDL_GetTicksNS();
+        if (!visible_ || now - lastRefreshNS_ < refreshNS)
+            return;
+        lastRefreshNS_ = now;
+
+        const auto frames = core::Profiler::instance().snapshot();
+        std::string text = "zone: p50 / p95 / p99 ms";
+        char line[96];
+        for (std::size_t z = 0; z < core::profileZoneCount; ++z)
+        {
+            const core::ProfileZone zone = static_cast<core::ProfileZone>(z);
+            std::snprintf(line, sizeof(line), "<br/>%s: %.2f / %.2f / %.2f", core::profileZoneName(zone),
+                          core::Profiler::percentileMS(frames, zone, 0.5f),
+                          core::Profiler::percentileMS(frames, zone, 0.95f),
+                          core::Profiler::percentileMS(frames, zone, 0.99f));
+            text += line;
+        }
+        std::snprintf(line, sizeof(line), "<br/>cpu ms/s: idle %.1f, continuous %.1f",
+                      core::Profiler::instance().getCpuMSPerSecond(true), core::Profiler::instance().getCpuMSPerSecond(false));
+        text += line;
+        appendHistogram(text);
+        text_->SetInnerRML(text);
+        // Документы сцен открываются позже - держим таблицу сверху
+        doc_->PullToFront();
+    }
+
+private:
+    Rml::ElementDocument *doc_ = nullptr;
+    Rml::Element *text_ = nullptr;
+    bool visible_ = false;
+    Uint64 lastRefreshNS_ = 0;
+
+private:
+    // Корзины интервалов кадров, где больше 1% кадров
+    static void appendHistogram(std::string &text)
+    {
+        const core::FrameTimeHistogram &hist = core::Profiler::instance().getHistogram();
+        if (hist.total == 0)
+            return;
+        text += "<br/>frame interval:";
+        char line[64];
+        for (std::size_t i = 0; i < core::FrameTimeHistogram::bucketCount; ++i)
+        {
+            const float share = static_cast<float>(hist.buckets[i]) / hist.total;
+            if (share < 0.01f)
+                continue;
+            std::snprintf(line, sizeof(line), "<br/>%5.1f ms: %4.1f%%", i * core::FrameTimeHistogram::bucketUS / 1000.f, share * 100.f);
+            text += line;
+        }
+    }
+
+    void load(Context &context)
+    {
+        static constexpr const char *rml = R"(
+<rml>
+<head>
+<style>
+body {
+    position: absolute;
+    left: 4dp;
+    top: 4dp;
+    width: 240dp;
+    padding: 4dp;
+    font-family: "DejaVu Sans";
+    font-size: 11dp;
+    color: #4f4;
+    background-color: #000b;
+    pointer-events: none;
+}
+</style>
+</head>
+<body><div id="profiler-text"></div></body>
+</rml>)";
+        doc_ = context.getContext()->LoadDocumentFromMemory(rml, "profiler-overlay");
+        if (!doc_)
+        {
+            SDL_Log("ProfilerOverlay: failed to load document");
+            return;
+        }
+        text_ = doc_->GetElementById("profiler-text");
+    }
+};
+
+} // namespace engine
@@ -29,6 +29,13 @@ public:
 
     virtual void draw(sdl3::RenderWindow &window) const = 0;
 
+    // true - сцене нечего обновлять без ввода (меню): движок ждёт событий
+    // или анимаций RmlUi вместо постоянной перерисовки
+    virtual bool isIdle() const
+    {
+        return false;
+    }
+
     virtual void hide()
     {
     }
@@ -0,0 +1,63 @@
+// Упаковщик пакетов: config.xml + картинки -> pack.upack (см. App/IO/UPackIO.hpp)
+// UnionsPacker <папка objects> [пакет ...] - без списка собираются все папки с config.xml
+
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <SDL3/SDL_log.h>
+
+#include <App/HardStrings.hpp>
+#include <App/IO/FullFileWorker.hpp>
+#include <App/IO/ObjectPackIO.hpp>
+#include <App/IO/UPackIO.hpp>
+#include <App/Render/TextureAtlas.hpp>
+#include <App/Resources/ObjectPack.hpp>
+
+static bool packFolder(const std::filesystem::path &objectsRoot, const std::string &packName)
+{
+    const std::filesystem::path folder = objectsRoot / packName;
+
+    resources::ObjectPack pack;
+    IO::PackMediaFiles media;
+    if (!IO::parseObjectPack(pack, media, packName, folder))
+    {
+        SDL_Log("UPacker: failed to parse %s", packName.c_str());
+        return false;
+    }
+
+    render::TextureAtlas &atlas = pack.getOwnAtlas();
+    for (const auto &[key, file] : media.textures)
+        if (!atlas.add(key, file))
+            return false;
+    if (!atlas.compose(render::TextureAtlas::maxPageSize))
+        return false;
+
+    const std::string data = IO::upack::writeUPack(pack, atlas.getComposedPages(), folder);
+    if (!IO::writeAllFile(folder / assets::packagBinary, data))
+        return false;
+    SDL_Log("UPacker: %s - %zu objects, %zu pages, %zu bytes", packName.c_str(), pack.getAll().size(), atlas.getComposedPages().size(), data.size());
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2)
+    {
+        SDL_Log("Usage: UnionsPacker <objects folder> [pack ...]");
+        return EXIT_FAILURE;
+    }
+    const std::filesystem::path objectsRoot = argv[1];
+
+    std::vector<std::string> packs(argv + 2, argv + argc);
+    if (packs.empty())
+        for (const auto &entry : std::filesystem::directory_iterator(objectsRoot))
+            if (entry.is_directory() && std::filesystem::exists(entry.path() / assets::packagConf))
+                packs.push_back(entry.path().filename().string());
+
+    bool ok = true;
+    for (const std::string &pack : packs)
+        ok = packFolder(objectsRoot, pack) && ok;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
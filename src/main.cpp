@@ -1,23 +1,101 @@
+#include <SDL3/SDL_events.h>
 #include <SDL3/SDL_hints.h>
 #include <SDL3/SDL_init.h>
 #include <SDL3/SDL_main.h>
 
+#include <cstdlib>
+#include <string_view>
+
 #include <SDLWrapper/SDL3GlobalMeneger.hpp>
 
 #include <App/AppScenesFactory.hpp>
 #include <App/AppState.hpp>
+#include <App/GameObjects/HeadlessGameSim.hpp>
 #include <App/HardStrings.hpp>
+#include <App/Resources/PackPrewarm.hpp>
 #include <App/Scenes/IDs.hpp>
 #include <App/Scenes/MainMenuScene.hpp>
+#include <App/UiVertexBenchmark.hpp>
 #include <Core/Managers/PathMeneger.hpp>
 #include <Engine/Engine.hpp>
 
 
 static engine::Engine game;
 static app::AppState appState;
+static bool headless = false;
+
+// --headless <pack> [drops] [seed] [adaptive|sectors|both] - симуляция без окна и звука, результат в лог.
+// Последний аргумент - построитель тел эллипсов; both - два прогона с одним seed для сравнения
+static SDL_AppResult runHeadless(int argc, char *argv[])
+{
+    headless = true;
+    core::managers::PathManager::init();
+
+    objects::HeadlessSimSettings setts;
+    setts.packName = argc > 2 ? argv[2] : "coins";
+    if (argc > 3)
+        setts.drops = static_cast<unsigned int>(std::strtoul(argv[3], nullptr, 10));
+    if (argc > 4)
+        setts.seed = std::strtoull(argv[4], nullptr, 10);
+
+    objects::HeadlessGameSim sim(core::managers::PathManager::assets() / assets::packages);
+    if (!sim.load(setts.packName))
+    {
+        SDL_Log("Headless: failed to load object pack: %s", setts.packName.c_str());
+        return SDL_APP_FAILURE;
+    }
+    const std::string_view ellipse = argc > 5 ? argv[5] : "adaptive";
+    if (ellipse != "sectors")
+        objects::logReport(setts, sim.run(setts));
+    if (ellipse == "sectors" || ellipse == "both")
+    {
+        setts.ellipse = physics::EntityFactory::EllipseBuilder::Sectors;
+        objects::logReport(setts, sim.run(setts));
+    }
+    return SDL_APP_SUCCESS;
+}
+
+// --bench-ui [iterations] - замер ядра вершин RmlUi на документах игры и настроек
+static SDL_AppResult runUiBenchmark(int argc, char *argv[])
+{
+    headless = true;
+    core::managers::PathManager::init();
+
+    const unsigned int iterations = argc > 2 ? static_cast<unsigned int>(std::strtoul(argv[2], nullptr, 10)) : 2000;
+    app::runUiVertexBenchmark(
+        {core::managers::PathManager::assets() / ui::gameMenu::file,
+         core::managers::PathManager::assets() / ui::setsMenu::file},
+        iterations > 0 ? iterations : 1);
+    return SDL_APP_SUCCESS;
+}
+
+// Все пакеты из статистики декодируются параллельно, GameScene потом не ждёт диска и декодеров
+static void prewarmPacks()
+{
+    std::vector<std::string> packs;
+    for (const auto &gs : appState.stat().getAll())
+        packs.push_back(gs.stringID);
+    resources::logReport(resources::prewarmPacks(core::managers::PathManager::assets() / assets::packages, packs, appState.images(), appState.audios()));
+}
+
+// Индекс пакетов для меню выбора; разбираются только новые и изменённые пакеты
+static void refreshPackIndex()
+{
+    std::vector<std::string> packs;
+    for (const auto &gs : appState.stat().getAll())
+        packs.push_back(gs.stringID);
+    appState.packIndex().setFiles(core::managers::PathManager::workFolder() / names::packIndexFile, core::managers::PathManager::workFolder() / names::packThumbnailsFile);
+    if (!appState.packIndex().refresh(core::managers::PathManager::assets() / assets::packages, packs))
+        SDL_Log("Pack index is not saved");
+}
 
 SDL_AppResult SDL_AppInit(void **appstate, int argc, char *argv[])
 {
+    if (argc > 1 && std::string_view(argv[1]) == "--headless")
+        return runHeadless(argc, argv);
+    if (argc > 1 && std::string_view(argv[1]) == "--bench-ui")
+        return runUiBenchmark(argc, argv);
+
     if(!sdl3::SDL3GlobalMeneger::init(false, true))
     {
         SDL_Log("Error of sdl3::SDL3GlobalMeneger::init");
@@ -37,6 +115,8 @@ SDL_AppResult SDL_AppInit(void **appstate, int argc, char *argv[])
         SDL_Log("Error! appSate not loaded");
         return SDL_APP_FAILURE;
     }
+    refreshPackIndex();
+
     auto fabrick = std::make_unique<app::AppScenesFactory>();
     fabrick->setAppState(appState);
 
@@ -53,11 +133,19 @@ SDL_AppResult SDL_AppInit(void **appstate, int argc, char *argv[])
     settings.setLogicalPresentation = true;
     settings.scenesFabrick = std::move(fabrick);
 
-    return game.start(std::move(settings));
+    const SDL_AppResult res = game.start(std::move(settings));
+    if (res == SDL_APP_CONTINUE)
+        prewarmPacks();
+    return res;
 }
 
 SDL_AppResult SDL_AppEvent(void *appstate, SDL_Event *event)
 {
+    // Android может выгрузить приложение в фоне без SDL_AppQuit
+    if (event->type == SDL_EVENT_WILL_ENTER_BACKGROUND)
+        appState.flush();
+    else if (event->type == SDL_EVENT_TERMINATING)
+        appState.save();
     return game.updateEvents(*event);
 }
 
@@ -68,7 +156,12 @@ SDL_AppResult SDL_AppIterate(void *appstate)
 
 void SDL_AppQuit(void *appstate, SDL_AppResult result)
 {
+    if (headless)
+        return;
+    // Сцены первыми: ~GameScene записывает итог идущей игры
+    game.closeScenes();
     appState.save();
+    appState.releaseGpuResources();
     game.close();
     sdl3::SDL3GlobalMeneger::shutdown();
 }